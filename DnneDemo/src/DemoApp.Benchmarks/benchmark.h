@@ -0,0 +1,16 @@
+#pragma once
+
+#include "TSMoreland.Interop.Portable.Benchmarks/benchmark_harness.h"
+
+namespace tsmoreland::samples::dnne_demo::benchmarks {
+
+    using tsmoreland::benchmarks::arguments;
+    using tsmoreland::benchmarks::benchmark_clock;
+    using tsmoreland::benchmarks::best_of_ns;
+    using tsmoreland::benchmarks::do_not_optimize;
+
+    int cold_start_benchmark(arguments args);
+    int dto_bulk_benchmark(arguments args);
+    int dto_scan_benchmark(arguments args);
+
+} // namespace tsmoreland::samples::dnne_demo::benchmarks
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark.h"
+#include "netframework_library.h"
+#include "runtime_activation.h"
+
+namespace tsmoreland::samples::dnne_demo::benchmarks {
+
+    namespace {
+        struct cold_start_options {
+            bool preactivate{false};
+            std::size_t samples{100'000};
+        };
+
+        /// <exception cref="std::invalid_argument">
+        /// if <paramref name="value"/> isn't entirely a positive decimal number
+        /// </exception>
+        [[nodiscard]]
+        std::size_t parse_count(std::string_view const name, std::string_view const value) {
+            std::size_t count{};
+            auto const [end, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+            if (error != std::errc{} || end != value.data() + value.size() || count == 0) {
+                throw std::invalid_argument("invalid value for " + std::string(name) + ": " + std::string(value));
+            }
+            return count;
+        }
+
+        [[nodiscard]]
+        cold_start_options parse_options(arguments const args) {
+            cold_start_options options{};
+            for (std::size_t i = 0; i < args.size(); i++) {
+                std::string_view const name{args[i]};
+                if (name == "--preactivate") {
+                    options.preactivate = true;
+                } else if (name == "--samples") {
+                    if (i + 1 == args.size()) {
+                        throw std::invalid_argument("missing value for " + std::string(name));
+                    }
+                    options.samples = parse_count(name, args[++i]);
+                } else {
+                    throw std::invalid_argument("unknown option " + std::string(name));
+                }
+            }
+            return options;
+        }
+
+        template <typename Call>
+        [[nodiscard]]
+        double time_call_ns(Call const& call) {
+            auto const start = benchmark_clock::now();
+            do_not_optimize(call());
+            return std::chrono::duration<double, std::nano>(benchmark_clock::now() - start).count();
+        }
+
+        /// <summary>
+        /// times the first call to <paramref name="call"/> then <paramref name="samples"/> individual calls
+        /// after as many untimed ones, printing the first call against the steady state distribution
+        /// </summary>
+        template <typename Call>
+        void measure(char const* const name, Call const& call, std::size_t const samples) {
+            double const first_call_ns = time_call_ns(call);
+
+            for (std::size_t i = 0; i < samples; i++) {
+                do_not_optimize(call());
+            }
+            std::vector<double> steady_state(samples);
+            for (double& sample : steady_state) {
+                sample = time_call_ns(call);
+            }
+            std::ranges::sort(steady_state);
+            auto const percentile = [&steady_state](double const fraction) {
+                auto const rank = static_cast<std::size_t>(fraction * static_cast<double>(steady_state.size()));
+                return steady_state[std::min(rank, steady_state.size() - 1)];
+            };
+
+            std::printf("%-8s %14.0f ns %10.1f ns %10.1f ns %10.1f ns\n", name, first_call_ns, percentile(0.5),
+                percentile(0.99), percentile(0.999));
+        }
+    } // namespace
+
+    /// <summary>
+    /// latency of the first call to <c>get_2x</c> and <c>get_dto</c> in the process against their steady
+    /// state, with the runtime started by the first call or, given --preactivate, by
+    /// <see cref="preactivate_runtime"/> beforehand
+    /// </summary>
+    /// <param name="args">[--preactivate] [--samples N]</param>
+    /// <remarks>
+    /// the first call and activation only happen once per process so each configuration needs its own run
+    /// </remarks>
+    int cold_start_benchmark(arguments const args) {
+        cold_start_options options{};
+        try {
+            options = parse_options(args);
+        } catch (std::invalid_argument const& ex) {
+            std::fprintf(stderr, "%s\nusage: cold_start [--preactivate] [--samples N]\n", ex.what());
+            return 1;
+        }
+
+        if (options.preactivate) {
+            activation_result const activation = preactivate_runtime();
+            if (!activation.succeeded()) {
+                throw std::runtime_error("runtime activation failed with " + std::to_string(activation.status));
+            }
+            std::printf("runtime activation: %lld ns\n", static_cast<long long>(activation.elapsed.count()));
+        } else {
+            std::printf("runtime activation: on first call\n");
+        }
+
+        std::printf("%-8s %17s %13s %13s %13s\n", "export", "first call", "p50", "p99", "p99.9");
+        measure("get_2x", [] { return get_2x(4); }, options.samples);
+        measure(
+            "get_dto",
+            [] {
+                DataTransferObject dto{};
+                return get_dto(4, &dto) + dto.isValid;
+            },
+            options.samples);
+        return 0;
+    }
+
+} // namespace tsmoreland::samples::dnne_demo::benchmarks
@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "netframework_library.h"
+
+namespace tsmoreland::samples::dnne_demo::benchmarks {
+
+    namespace {
+        constexpr int True = 0;
+
+        [[nodiscard]]
+        bool same_dto(DataTransferObject const& lhs, DataTransferObject const& rhs) noexcept {
+            return lhs.length == rhs.length && lhs.isValid == rhs.isValid;
+        }
+    } // namespace
+
+    /// <summary>
+    /// fills an array of DataTransferObject with one <c>get_dto</c> call per item, checking each result, against
+    /// a single <c>get_dtos</c> call
+    /// </summary>
+    /// <param name="args">optional number of objects, defaults to 500000</param>
+    int dto_bulk_benchmark(arguments const args) {
+        int const count           = args.empty() ? 500'000 : std::stoi(args[0]);
+        constexpr int repetitions = 10;
+
+        std::vector<int> lengths(static_cast<std::size_t>(count));
+        std::iota(lengths.begin(), lengths.end(), 0);
+        std::vector<DataTransferObject> per_item(lengths.size());
+        std::vector<DataTransferObject> bulk(lengths.size());
+
+        double const per_item_ns = best_of_ns(repetitions, [&] {
+            for (std::size_t i = 0; i < lengths.size(); i++) {
+                if (get_dto(lengths[i], &per_item[i]) != True) {
+                    throw std::runtime_error("get_dto failed at " + std::to_string(i));
+                }
+            }
+            do_not_optimize(per_item);
+        });
+        double const bulk_ns = best_of_ns(repetitions, [&] {
+            if (int const filled = get_dtos(lengths.data(), count, bulk.data()); filled != count) {
+                throw std::runtime_error("get_dtos failed at " + std::to_string(filled));
+            }
+            do_not_optimize(bulk);
+        });
+
+        if (!std::ranges::equal(per_item, bulk, same_dto)) {
+            throw std::runtime_error("get_dto and get_dtos results differ");
+        }
+
+        std::printf("objects: %d, best of %d runs\n", count, repetitions);
+        std::printf("%-22s %10.3f ms %10.3f ns/object\n", "get_dto (per object)", per_item_ns / 1e6,
+            per_item_ns / count);
+        std::printf("%-22s %10.3f ms %10.3f ns/object\n", "get_dtos (bulk)", bulk_ns / 1e6, bulk_ns / count);
+        std::printf("speedup: %.1fx\n", per_item_ns / bulk_ns);
+        return 0;
+    }
+
+} // namespace tsmoreland::samples::dnne_demo::benchmarks
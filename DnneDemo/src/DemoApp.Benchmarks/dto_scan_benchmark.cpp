@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "dto_scan.h"
+#include "netframework_library.h"
+
+namespace tsmoreland::samples::dnne_demo::benchmarks {
+
+    namespace {
+        constexpr char const* kernel_names[] = {"scalar", "sse2", "avx2"};
+
+        void report(char const* const layout, char const* const kernel, std::size_t const rows, double const count_ns,
+            double const compact_ns) {
+            // throughput is of the whole batch, rows * sizeof(DataTransferObject), whichever layout it's held in
+            auto const batch_bytes = static_cast<double>(rows * sizeof(DataTransferObject));
+            std::printf("%-8s %-8s %12.2f GB/s %12.2f GB/s\n", layout, kernel, batch_bytes / count_ns,
+                batch_bytes / compact_ns);
+        }
+    } // namespace
+
+    /// <summary>
+    /// counting and compacting valid rows of a batch fetched as an array of DataTransferObject with
+    /// <c>get_dtos</c> against the same batch fetched as separate columns with <c>get_dtos_soa</c> and scanned
+    /// with each supported kernel
+    /// </summary>
+    /// <param name="args">optional number of rows, defaults to 10000000</param>
+    int dto_scan_benchmark(arguments const args) {
+        int const count           = args.empty() ? 10'000'000 : std::stoi(args[0]);
+        auto const rows           = static_cast<std::size_t>(count);
+        constexpr int repetitions = 10;
+
+        // random lengths so validity, which depends on the length, doesn't follow a pattern the branch predictor
+        // or a single permutation could learn
+        std::vector<int> lengths(rows);
+        std::mt19937 engine{42};
+        std::uniform_int_distribution<int> distribution{0, 4096};
+        std::ranges::generate(lengths, [&] { return distribution(engine); });
+
+        std::vector<DataTransferObject> dtos(rows);
+        std::vector<int> length(rows);
+        std::vector<int> is_valid(rows);
+        std::vector<int> valid_lengths(rows);
+
+        double const aos_fetch_ns = best_of_ns(repetitions, [&] {
+            if (get_dtos(lengths.data(), count, dtos.data()) != count) {
+                throw std::runtime_error("get_dtos failed");
+            }
+        });
+        double const soa_fetch_ns = best_of_ns(repetitions, [&] {
+            if (get_dtos_soa(lengths.data(), count, length.data(), is_valid.data()) != count) {
+                throw std::runtime_error("get_dtos_soa failed");
+            }
+        });
+
+        std::printf("rows: %d, best of %d runs\n", count, repetitions);
+        std::printf("fetch: get_dtos %.3f ms, get_dtos_soa %.3f ms\n\n", aos_fetch_ns / 1e6, soa_fetch_ns / 1e6);
+        std::printf("%-8s %-8s %17s %17s\n", "layout", "kernel", "count", "compact");
+
+        std::size_t expected_valid = 0;
+        double const aos_count_ns = best_of_ns(repetitions, [&] {
+            expected_valid = static_cast<std::size_t>(
+                std::ranges::count_if(dtos, [](DataTransferObject const& dto) { return dto.isValid != 0; }));
+        });
+        double const aos_compact_ns = best_of_ns(repetitions, [&] {
+            std::size_t written = 0;
+            for (DataTransferObject const& dto : dtos) {
+                if (dto.isValid != 0) {
+                    valid_lengths[written++] = dto.length;
+                }
+            }
+            do_not_optimize(written);
+        });
+        report("aos", "scalar", rows, aos_count_ns, aos_compact_ns);
+        std::vector<int> const expected_lengths(
+            valid_lengths.begin(), valid_lengths.begin() + static_cast<std::ptrdiff_t>(expected_valid));
+
+        for (scan_kernel const kernel : {scan_kernel::scalar, scan_kernel::sse2, scan_kernel::avx2}) {
+            char const* const name = kernel_names[static_cast<int>(kernel)];
+            if (!is_supported(kernel)) {
+                std::printf("%-8s %-8s %17s %17s\n", "soa", name, "unsupported", "unsupported");
+                continue;
+            }
+
+            std::size_t valid           = 0;
+            double const soa_count_ns   = best_of_ns(repetitions, [&] { valid = count_valid(is_valid, kernel); });
+            double const soa_compact_ns = best_of_ns(repetitions, [&] {
+                do_not_optimize(compact_valid(length, is_valid, valid_lengths, kernel));
+            });
+
+            std::ranges::fill(valid_lengths, -1);
+            std::size_t const written = compact_valid(length, is_valid, valid_lengths, kernel);
+            if (valid != expected_valid || written != expected_valid ||
+                !std::equal(expected_lengths.begin(), expected_lengths.end(), valid_lengths.begin())) {
+                throw std::runtime_error(std::string(name) + " kernel results differ from the array of structs scan");
+            }
+            report("soa", name, rows, soa_count_ns, soa_compact_ns);
+        }
+
+        return 0;
+    }
+
+} // namespace tsmoreland::samples::dnne_demo::benchmarks
@@ -0,0 +1,13 @@
+#include "benchmark.h"
+
+namespace benchmarks = tsmoreland::samples::dnne_demo::benchmarks;
+
+constexpr tsmoreland::benchmarks::benchmark_entry available_benchmarks[] = {
+    {"cold_start", benchmarks::cold_start_benchmark},
+    {"dto_bulk", benchmarks::dto_bulk_benchmark},
+    {"dto_scan", benchmarks::dto_scan_benchmark},
+};
+
+int main(int argc, char* argv[]) {
+    return tsmoreland::benchmarks::run_benchmark({argv, static_cast<std::size_t>(argc)}, available_benchmarks);
+}
@@ -0,0 +1,169 @@
+#include "dto_scan.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+
+namespace tsmoreland::samples::dnne_demo {
+
+    namespace {
+
+        std::size_t count_valid_scalar(int const* is_valid, std::size_t const count) {
+            std::size_t valid = 0;
+            for (std::size_t i = 0; i < count; i++) {
+                valid += is_valid[i] != 0 ? 1 : 0;
+            }
+            return valid;
+        }
+
+        std::size_t compact_valid_scalar(int const* length, int const* is_valid, int* out, std::size_t const count) {
+            std::size_t written = 0;
+            for (std::size_t i = 0; i < count; i++) {
+                out[written] = length[i];
+                written += is_valid[i] != 0 ? 1 : 0;
+            }
+            return written;
+        }
+
+#ifdef TSMORELAND_INTEROP_X86
+
+        __m128i load_sse2(int const* values) {
+            return _mm_loadu_si128(reinterpret_cast<__m128i const*>(values));
+        }
+
+        // lanes count invalid rows, flushed to the total before a 32-bit lane could overflow
+        constexpr std::size_t blocks_per_flush = std::size_t{1} << 30;
+
+        /// <remarks>
+        /// subtracting the all ones compare result of each invalid row keeps a count per lane so the loop needs
+        /// no movemask or popcount
+        /// </remarks>
+        std::size_t count_valid_sse2(int const* is_valid, std::size_t const count) {
+            std::size_t invalid = 0;
+            std::size_t i       = 0;
+            while (i + 4 <= count) {
+                __m128i lanes      = _mm_setzero_si128();
+                std::size_t blocks = 0;
+                for (; i + 4 <= count && blocks < blocks_per_flush; i += 4, blocks++) {
+                    lanes = _mm_sub_epi32(lanes, _mm_cmpeq_epi32(load_sse2(is_valid + i), _mm_setzero_si128()));
+                }
+                alignas(16) std::uint32_t totals[4]{};
+                _mm_store_si128(reinterpret_cast<__m128i*>(totals), lanes);
+                invalid += std::size_t{totals[0]} + totals[1] + totals[2] + totals[3];
+            }
+            return i - invalid + count_valid_scalar(is_valid + i, count - i);
+        }
+
+        TSMORELAND_INTEROP_TARGET_AVX2
+        __m256i load_avx2(int const* values) {
+            return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(values));
+        }
+
+        TSMORELAND_INTEROP_TARGET_AVX2
+        unsigned valid_mask_avx2(int const* is_valid) {
+            __m256i const zero = _mm256_cmpeq_epi32(load_avx2(is_valid), _mm256_setzero_si256());
+            return ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(zero))) & 0xFFU;
+        }
+
+        TSMORELAND_INTEROP_TARGET_AVX2
+        std::size_t count_valid_avx2(int const* is_valid, std::size_t const count) {
+            std::size_t invalid = 0;
+            std::size_t i       = 0;
+            while (i + 8 <= count) {
+                __m256i lanes      = _mm256_setzero_si256();
+                std::size_t blocks = 0;
+                for (; i + 8 <= count && blocks < blocks_per_flush; i += 8, blocks++) {
+                    __m256i const zero = _mm256_cmpeq_epi32(load_avx2(is_valid + i), _mm256_setzero_si256());
+                    lanes              = _mm256_sub_epi32(lanes, zero);
+                }
+                alignas(32) std::uint32_t totals[8]{};
+                _mm256_store_si256(reinterpret_cast<__m256i*>(totals), lanes);
+                for (std::uint32_t const total : totals) {
+                    invalid += total;
+                }
+            }
+            return i - invalid + count_valid_scalar(is_valid + i, count - i);
+        }
+
+        /// <summary>
+        /// for each 8 bit validity mask the lane indices of the valid rows, in order, followed by unused lanes
+        /// </summary>
+        constexpr auto compact_permutations = [] {
+            std::array<std::array<std::int32_t, 8>, 256> permutations{};
+            for (unsigned mask = 0; mask < permutations.size(); mask++) {
+                std::size_t next = 0;
+                for (std::int32_t lane = 0; lane < 8; lane++) {
+                    if ((mask & (1U << lane)) != 0) {
+                        permutations[mask][next++] = lane;
+                    }
+                }
+            }
+            return permutations;
+        }();
+
+        /// <remarks>
+        /// each block of 8 rows is packed with a single permute and stored whole; the lanes past the valid rows
+        /// are overwritten by the next block, which is why the output must be as large as the input
+        /// </remarks>
+        TSMORELAND_INTEROP_TARGET_AVX2
+        std::size_t compact_valid_avx2(int const* length, int const* is_valid, int* out, std::size_t const count) {
+            std::size_t written = 0;
+            std::size_t i       = 0;
+            for (; i + 8 <= count; i += 8) {
+                unsigned const mask       = valid_mask_avx2(is_valid + i);
+                __m256i const permutation = load_avx2(compact_permutations[mask].data());
+                __m256i const packed      = _mm256_permutevar8x32_epi32(load_avx2(length + i), permutation);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + written), packed);
+                written += static_cast<std::size_t>(std::popcount(mask));
+            }
+            return written + compact_valid_scalar(length + i, is_valid + i, out + written, count - i);
+        }
+
+#endif
+
+        void throw_if_unsupported(scan_kernel const kernel) {
+            if (!is_supported(kernel)) {
+                throw std::invalid_argument("scan kernel is not supported by this processor");
+            }
+        }
+
+    } // namespace
+
+    std::size_t count_valid(std::span<int const> const is_valid, scan_kernel const kernel) {
+        throw_if_unsupported(kernel);
+        switch (kernel) {
+#ifdef TSMORELAND_INTEROP_X86
+        case scan_kernel::avx2:
+            return count_valid_avx2(is_valid.data(), is_valid.size());
+        case scan_kernel::sse2:
+            return count_valid_sse2(is_valid.data(), is_valid.size());
+#endif
+        default:
+            return count_valid_scalar(is_valid.data(), is_valid.size());
+        }
+    }
+
+    std::size_t compact_valid(std::span<int const> const length, std::span<int const> const is_valid,
+        std::span<int> const valid_lengths, scan_kernel const kernel) {
+        throw_if_unsupported(kernel);
+        if (length.size() != is_valid.size()) {
+            throw std::invalid_argument("length and is_valid must be the same size");
+        }
+        if (valid_lengths.size() < length.size()) {
+            throw std::invalid_argument("valid_lengths must be at least as large as length");
+        }
+
+        switch (kernel) {
+#ifdef TSMORELAND_INTEROP_X86
+        case scan_kernel::avx2:
+            return compact_valid_avx2(length.data(), is_valid.data(), valid_lengths.data(), length.size());
+#endif
+        // SSE2 has no variable permute to pack a block with, driving scalar stores from its mask measured slower
+        // than the branchless scalar loop so that is used instead
+        default:
+            return compact_valid_scalar(length.data(), is_valid.data(), valid_lengths.data(), length.size());
+        }
+    }
+
+} // namespace tsmoreland::samples::dnne_demo
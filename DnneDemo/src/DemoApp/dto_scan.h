@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "TSMoreland.Interop.Portable/cpu_features.h"
+
+namespace tsmoreland::samples::dnne_demo {
+
+    /// <summary>
+    /// instruction sets the validity scan can use, detected by the interop samples' portable cpu_features.h
+    /// </summary>
+    using scan_kernel = tsmoreland::interop::simd_kernel;
+    using tsmoreland::interop::is_supported;
+
+    /// <summary>
+    /// counts the rows whose <c>isValid</c> is non-zero in the isValid column of a struct of arrays batch
+    /// (see get_dtos_soa)
+    /// </summary>
+    /// <exception cref="std::invalid_argument">if <paramref name="kernel"/> isn't supported</exception>
+    [[nodiscard]]
+    std::size_t count_valid(std::span<int const> is_valid, scan_kernel kernel = tsmoreland::interop::best_simd_kernel());
+
+    /// <summary>
+    /// copies the length of each row whose <c>isValid</c> is non-zero to the front of
+    /// <paramref name="valid_lengths"/>, keeping their order
+    /// </summary>
+    /// <param name="valid_lengths">
+    /// must be at least as large as <paramref name="length"/>, vector kernels write whole registers so elements
+    /// after the returned count may be overwritten
+    /// </param>
+    /// <returns>the number of lengths written</returns>
+    /// <remarks>sse2 uses the scalar loop as it has no instruction to pack the valid rows of a block</remarks>
+    /// <exception cref="std::invalid_argument">
+    /// if the columns differ in size, <paramref name="valid_lengths"/> is too small or <paramref name="kernel"/>
+    /// isn't supported
+    /// </exception>
+    std::size_t compact_valid(std::span<int const> length, std::span<int const> is_valid, std::span<int> valid_lengths,
+        scan_kernel kernel = tsmoreland::interop::best_simd_kernel());
+
+} // namespace tsmoreland::samples::dnne_demo
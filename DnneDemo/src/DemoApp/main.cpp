@@ -1,12 +1,25 @@
 #include <iostream>
 #include <format>
+#include <vector>
 #include "netframework_library.h"
+#include "dto_scan.h"
+#include "runtime_activation.h"
 
 constexpr int True = 0;
 constexpr int False = 1;
 
+namespace dnne_demo = tsmoreland::samples::dnne_demo;
+
 int main()
 {
+    // start the runtime now rather than on the first call below
+    if (auto const activation = dnne_demo::preactivate_runtime(); activation.succeeded()) {
+        auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(activation.elapsed);
+        std::cout << std::format("runtime activated in {0}us", elapsed.count()) << "\n";
+    } else {
+        std::cout << std::format("runtime activation failed ({0})", activation.status) << "\n";
+    }
+
     constexpr int x = 4;
     int y = get_2x(x);
     std::cout << std::format("y = 2x -> {0} * 2 = {1}", x, y) << "\n";
@@ -19,6 +32,19 @@ int main()
     }
 
     std::cout << std::format("dto ( length: {0}, isValid: {1} )", dto.length, dto.isValid) << "\n";
+
+    constexpr int lengths[] = {1, 2, 3, 4, 5};
+    constexpr int count     = static_cast<int>(std::size(lengths));
+    std::vector<int> length(count);
+    std::vector<int> is_valid(count);
+    if (get_dtos_soa(lengths, count, length.data(), is_valid.data()) != count) {
+        std::cout << "failed to get dtos" << "\n";
+        return False;
+    }
+
+    std::vector<int> valid_lengths(length.size());
+    auto const valid = dnne_demo::compact_valid(length, is_valid, valid_lengths);
+    std::cout << std::format("{0} of {1} dtos are valid", valid, length.size()) << "\n";
     return 0;
 }
 
@@ -0,0 +1,34 @@
+#include "runtime_activation.h"
+
+#include <atomic>
+
+#include "netframework_library.h"
+
+namespace tsmoreland::samples::dnne_demo {
+
+    namespace {
+        std::atomic<activation_result const*> completed_activation{nullptr};
+    } // namespace
+
+    activation_result preactivate_runtime() noexcept {
+        // initialization of a function local static is thread safe so concurrent callers wait for the one
+        // activating the runtime rather than starting it again
+        static activation_result const result = [] {
+            auto const start = std::chrono::steady_clock::now();
+            int const status = try_preload_runtime();
+            return activation_result{status,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)};
+        }();
+
+        completed_activation.store(&result, std::memory_order_release);
+        return result;
+    }
+
+    std::optional<activation_result> get_activation_result() noexcept {
+        if (auto const* result = completed_activation.load(std::memory_order_acquire); result != nullptr) {
+            return *result;
+        }
+        return std::nullopt;
+    }
+
+} // namespace tsmoreland::samples::dnne_demo
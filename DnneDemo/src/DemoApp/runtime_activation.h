@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+namespace tsmoreland::samples::dnne_demo {
+
+    struct activation_result {
+        /// <summary>
+        /// status returned by DNNE's <c>try_preload_runtime</c>, 0 when the runtime was started
+        /// </summary>
+        int status{};
+        std::chrono::nanoseconds elapsed{};
+
+        [[nodiscard]]
+        bool succeeded() const noexcept {
+            return status == 0;
+        }
+    };
+
+    /// <summary>
+    /// starts the .NET runtime hosting netframework_library's exports ahead of the first exported call, which
+    /// would otherwise start it and pay the whole activation cost; meant to be called at startup
+    /// </summary>
+    /// <remarks>
+    /// only the first call activates the runtime, later calls (including concurrent ones) return its result.
+    /// If activation fails the first exported call will try again.
+    /// </remarks>
+    activation_result preactivate_runtime() noexcept;
+
+    /// <returns>the result of <see cref="preactivate_runtime"/>, or an empty optional if it hasn't been called</returns>
+    [[nodiscard]]
+    std::optional<activation_result> get_activation_result() noexcept;
+
+} // namespace tsmoreland::samples::dnne_demo
@@ -29,7 +29,57 @@ public sealed class Dto
             return 1;
         }
 
-        *data = new SampleStruct { Length = length, IsValid = length % 2 == 0 ? 0 : 1};
+        *data = Create(length);
         return 0;
     }
+
+    /// <summary>
+    /// fills <paramref name="data"/> with the DataTransferObject for each of <paramref name="count"/> values of
+    /// <paramref name="lengths"/> in a single call, the result is the same as calling get_dto once per length
+    /// </summary>
+    /// <returns>
+    /// the number of objects written, which is <paramref name="count"/> unless an item fails in which case it's
+    /// the index of the first failed item; -1 if either pointer is null or <paramref name="count"/> is negative
+    /// </returns>
+    [DNNE.Export(EntryPoint = "get_dtos")]
+    public static unsafe int GetDtos([DNNE.C99Type("const int*")] int* lengths, int count, [DNNE.C99Type("struct DataTransferObject*")] SampleStruct* data)
+    {
+        if (lengths == null || data == null || count < 0)
+        {
+            return -1;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            data[i] = Create(lengths[i]);
+        }
+        return count;
+    }
+
+    /// <summary>
+    /// struct of arrays form of get_dtos, writes the fields of each DataTransferObject to the separate
+    /// <paramref name="length"/> and <paramref name="isValid"/> arrays so a column can be scanned with contiguous loads
+    /// </summary>
+    /// <returns>as get_dtos; -1 if any pointer is null or <paramref name="count"/> is negative</returns>
+    [DNNE.Export(EntryPoint = "get_dtos_soa")]
+    public static unsafe int GetDtosSoa([DNNE.C99Type("const int*")] int* lengths, int count, int* length, int* isValid)
+    {
+        if (lengths == null || length == null || isValid == null || count < 0)
+        {
+            return -1;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            SampleStruct dto = Create(lengths[i]);
+            length[i] = dto.Length;
+            isValid[i] = dto.IsValid;
+        }
+        return count;
+    }
+
+    private static SampleStruct Create(int length)
+    {
+        return new SampleStruct { Length = length, IsValid = length % 2 == 0 ? 0 : 1};
+    }
 }
@@ -0,0 +1,57 @@
+#include <cstdio>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "csharp_interop_aot.h"
+
+namespace tsmoreland::samples::csharp_interop_aot::benchmarks {
+
+    /// <summary>
+    /// compares one native to managed transition per pair of values (<c>add</c>) against a single
+    /// transition for the whole workload (<c>add_many</c>)
+    /// </summary>
+    /// <param name="args">optional element count, defaults to one million</param>
+    int add_many_benchmark(arguments const args) {
+        std::size_t const count = args.empty() ? 1'000'000 : std::stoul(args[0]);
+        constexpr int repetitions = 10;
+
+        calculator const calc{};
+
+        std::vector<int> x(count);
+        std::vector<int> y(count);
+        std::vector<int> result(count);
+        std::iota(x.begin(), x.end(), 0);
+        std::iota(y.begin(), y.end(), 1);
+
+        double const per_element_ns = best_of_ns(repetitions, [&] {
+            for (std::size_t i = 0; i < count; i++) {
+                result[i] = calc.add(x[i], y[i]);
+            }
+            do_not_optimize(result.back());
+        });
+
+        double const batched_ns = best_of_ns(repetitions, [&] {
+            calc.add_many(x, y, result);
+            do_not_optimize(result.back());
+        });
+
+        for (std::size_t i = 0; i < count; i++) {
+            if (result[i] != x[i] + y[i]) {
+                throw std::runtime_error("add_many produced an incorrect result at index " + std::to_string(i));
+            }
+        }
+
+        auto const elements = static_cast<double>(count);
+        std::printf("elements: %zu, best of %d runs\n", count, repetitions);
+        std::printf("%-22s %12.3f ms %10.3f ns/element\n", "add (per element)", per_element_ns / 1e6,
+            per_element_ns / elements);
+        std::printf("%-22s %12.3f ms %10.3f ns/element\n", "add_many (batched)", batched_ns / 1e6,
+            batched_ns / elements);
+        std::printf("speedup: %.1fx\n", per_element_ns / batched_ns);
+        return 0;
+    }
+
+} // namespace tsmoreland::samples::csharp_interop_aot::benchmarks
@@ -0,0 +1,73 @@
+#include <cstdio>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "async_calculator.h"
+#include "benchmark.h"
+#include "csharp_interop_aot.h"
+
+namespace tsmoreland::samples::csharp_interop_aot::benchmarks {
+
+    namespace {
+        /// <summary>
+        /// runs <paramref name="producer"/> on <paramref name="threads"/> threads at once returning the elapsed time
+        /// </summary>
+        template <typename Producer>
+        [[nodiscard]]
+        double run_producers(unsigned int const threads, Producer const& producer) {
+            auto const start = benchmark_clock::now();
+            {
+                std::vector<std::jthread> producers;
+                for (unsigned int t = 0; t < threads; t++) {
+                    producers.emplace_back(producer);
+                }
+            }
+            return std::chrono::duration<double, std::nano>(benchmark_clock::now() - start).count();
+        }
+    } // namespace
+
+    /// <summary>
+    /// throughput of synchronous <c>add</c> calls made directly from N threads against <c>add_async</c> served by
+    /// N workers with N producers, for N from 1 to the hardware concurrency
+    /// </summary>
+    /// <param name="args">optional requests per producer, defaults to one hundred thousand</param>
+    int async_scaling_benchmark(arguments const args) {
+        std::size_t const requests   = args.empty() ? 100'000 : std::stoull(args[0]);
+        unsigned int const max_cores = std::max(1U, std::thread::hardware_concurrency());
+
+        calculator const calc{};
+
+        std::printf("requests per producer: %zu\n", requests);
+        std::printf("%8s %20s %20s\n", "threads", "sync (M calls/s)", "async (M calls/s)");
+        for (unsigned int threads = 1; threads <= max_cores; threads++) {
+            double const sync_ns = run_producers(threads, [&calc, requests] {
+                int sum = 0;
+                for (std::size_t i = 0; i < requests; i++) {
+                    sum += calc.add(static_cast<int>(i), 1);
+                }
+                do_not_optimize(sum);
+            });
+
+            async_calculator const async_calc{threads};
+            double const async_ns = run_producers(threads, [&async_calc, requests] {
+                std::vector<std::future<int>> results;
+                results.reserve(requests);
+                for (std::size_t i = 0; i < requests; i++) {
+                    results.push_back(async_calc.add_async(static_cast<int>(i), 1));
+                }
+                int sum = 0;
+                for (auto& result : results) {
+                    sum += result.get();
+                }
+                do_not_optimize(sum);
+            });
+
+            auto const total = static_cast<double>(requests) * threads;
+            std::printf("%8u %20.2f %20.2f\n", threads, total / sync_ns * 1e3, total / async_ns * 1e3);
+        }
+        return 0;
+    }
+
+} // namespace tsmoreland::samples::csharp_interop_aot::benchmarks
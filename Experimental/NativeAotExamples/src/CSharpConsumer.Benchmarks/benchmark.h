@@ -0,0 +1,18 @@
+#pragma once
+
+#include "TSMoreland.Interop.Portable.Benchmarks/benchmark_harness.h"
+
+namespace tsmoreland::samples::csharp_interop_aot::benchmarks {
+
+    using tsmoreland::benchmarks::arguments;
+    using tsmoreland::benchmarks::benchmark_clock;
+    using tsmoreland::benchmarks::best_of_ns;
+    using tsmoreland::benchmarks::do_not_optimize;
+
+    int add_many_benchmark(arguments args);
+    int async_scaling_benchmark(arguments args);
+    int buffer_throughput_benchmark(arguments args);
+    int construction_benchmark(arguments args);
+    int interop_latency_benchmark(arguments args);
+
+} // namespace tsmoreland::samples::csharp_interop_aot::benchmarks
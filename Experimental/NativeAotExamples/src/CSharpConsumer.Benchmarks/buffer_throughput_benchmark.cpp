@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "csharp_interop_aot.h"
+
+namespace tsmoreland::samples::csharp_interop_aot::benchmarks {
+
+    namespace {
+        void report(char const* const name, std::size_t const bytes, double const zero_copy_ns, double const copied_ns) {
+            auto const gb = static_cast<double>(bytes);
+            std::printf("%-16s %12.2f GB/s %12.2f GB/s %8.1fx\n", name, gb / zero_copy_ns, gb / copied_ns,
+                copied_ns / zero_copy_ns);
+        }
+    } // namespace
+
+    /// <summary>
+    /// throughput of the in place buffer exports against a copy based path which, like default array marshaling,
+    /// copies the buffer into a separate staging buffer for the call and, for buffers written to, copies it back
+    /// </summary>
+    /// <param name="args">optional buffer size in MiB, defaults to 64</param>
+    int buffer_throughput_benchmark(arguments const args) {
+        std::size_t const bytes   = (args.empty() ? 64 : std::stoull(args[0])) * 1024 * 1024;
+        std::size_t const count   = bytes / sizeof(int);
+        constexpr int repetitions = 10;
+
+        calculator const calc{};
+
+        std::vector<int> values(count);
+        std::iota(values.begin(), values.end(), 0);
+        std::vector<int> staged_values;
+
+        std::string text(bytes, 'a');
+        for (std::size_t i = 0; i < text.size(); i += 7) {
+            text[i] = ' ';
+        }
+        std::string staged_text;
+
+        std::printf("buffer: %zu MiB, best of %d runs\n", bytes / (1024 * 1024), repetitions);
+        std::printf("%-16s %17s %17s %9s\n", "export", "zero copy", "copied", "speedup");
+
+        long long zero_copy_total = 0;
+        long long copied_total    = 0;
+        report("sum_buffer", bytes, best_of_ns(repetitions, [&] { zero_copy_total = calc.sum(values); }),
+            best_of_ns(repetitions, [&] {
+                staged_values.assign(values.begin(), values.end());
+                copied_total = calc.sum(staged_values);
+            }));
+        if (zero_copy_total != copied_total) {
+            throw std::runtime_error("sum_buffer results differ");
+        }
+
+        // a factor of 1 keeps the values stable across repetitions
+        report("scale_buffer", bytes, best_of_ns(repetitions, [&] { calc.scale(values, 1); }),
+            best_of_ns(repetitions, [&] {
+                staged_values.assign(values.begin(), values.end());
+                calc.scale(staged_values, 1);
+                std::ranges::copy(staged_values, values.begin());
+            }));
+
+        report("to_upper_utf8", bytes, best_of_ns(repetitions, [&] { calc.to_upper_utf8(text); }),
+            best_of_ns(repetitions, [&] {
+                staged_text.assign(text);
+                calc.to_upper_utf8(staged_text);
+                std::ranges::copy(staged_text, text.begin());
+            }));
+        if (text.find('a') != std::string::npos) {
+            throw std::runtime_error("to_upper_utf8 left lower case characters");
+        }
+
+        return 0;
+    }
+
+} // namespace tsmoreland::samples::csharp_interop_aot::benchmarks
@@ -0,0 +1,92 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "benchmark.h"
+#include "csharp_interop_aot.h"
+#include "native_library.h"
+
+namespace {
+    std::atomic<std::size_t> allocation_count{0};
+}
+
+// counts every allocation made by the benchmark process so construction can be shown to be allocation free
+void* operator new(std::size_t const size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* const memory = std::malloc(size == 0 ? 1 : size); memory != nullptr) {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+void operator delete(void* const memory) noexcept {
+    std::free(memory);
+}
+void operator delete(void* const memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+namespace tsmoreland::samples::csharp_interop_aot::benchmarks {
+
+    namespace {
+        /// <summary>
+        /// reproduces the original per instance construction, which loaded the library and resolved its
+        /// exports into a heap allocated table for every calculator
+        /// </summary>
+        class per_instance_calculator final {
+            struct exports {
+                int (*add)(int, int);
+                int (*add_many)(int const*, int const*, int*, int);
+            };
+            std::unique_ptr<exports> exports_;
+
+        public:
+            per_instance_calculator() : exports_{std::make_unique<exports>()} {
+                native_library const library{aot_library_path};
+                exports_->add      = library.resolve<decltype(exports::add)>("add");
+                exports_->add_many = library.resolve<decltype(exports::add_many)>("add_many");
+            }
+
+            [[nodiscard]]
+            int add(int const x, int const y) const {
+                return exports_->add(x, y);
+            }
+        };
+
+        template <typename Calculator>
+        void report(char const* const name, int const iterations, int const repetitions) {
+            auto const allocations_before = allocation_count.load();
+            double const elapsed_ns       = best_of_ns(repetitions, [iterations] {
+                for (int i = 0; i < iterations; i++) {
+                    Calculator const calc{};
+                    do_not_optimize(calc);
+                }
+            });
+            auto const allocations = allocation_count.load() - allocations_before;
+
+            std::printf("%-14s %10.1f ns/construction %8.2f allocations/construction\n", name,
+                elapsed_ns / iterations, static_cast<double>(allocations) / (static_cast<double>(iterations) * repetitions));
+        }
+    } // namespace
+
+    /// <summary>
+    /// measures the cost of constructing a calculator using the original per instance loading against the
+    /// process wide export registry
+    /// </summary>
+    /// <param name="args">optional number of constructions per run, defaults to one hundred thousand</param>
+    int construction_benchmark(arguments const args) {
+        int const iterations      = args.empty() ? 100'000 : std::stoi(args[0]);
+        constexpr int repetitions = 5;
+
+        // both approaches share the cost of the very first load, keep it out of the measurement
+        initialize_csharp_interop_aot();
+
+        std::printf("constructions: %d, best of %d runs\n", iterations, repetitions);
+        report<per_instance_calculator>("per instance", iterations, repetitions);
+        report<calculator>("registry", iterations, repetitions);
+        return 0;
+    }
+
+} // namespace tsmoreland::samples::csharp_interop_aot::benchmarks
@@ -0,0 +1,272 @@
+#include <algorithm>
+#include <barrier>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "csharp_interop_aot.h"
+#include "native_library.h"
+
+namespace tsmoreland::samples::csharp_interop_aot::benchmarks {
+
+    namespace {
+        // matches the declaration DNNE generates from DnneDemo/src/NetFrameworkLibrary/Dto.cs
+        struct DataTransferObject {
+            int length;
+            int isValid;
+        };
+
+        struct latency_options {
+            unsigned int threads{std::max(1U, std::thread::hardware_concurrency())};
+            std::size_t samples{100'000};
+            std::size_t warm_up_calls{10'000};
+            std::size_t cold_threads{64};
+            std::optional<std::string> dnne_library{};
+            std::optional<std::string> output{};
+        };
+
+        struct latency_summary {
+            std::string scenario;
+            unsigned int threads{1};
+            std::size_t samples{};
+            double min_ns{};
+            double mean_ns{};
+            double p50_ns{};
+            double p99_ns{};
+            double p999_ns{};
+            double max_ns{};
+        };
+
+        struct target_result {
+            std::string name;
+            std::vector<latency_summary> scenarios;
+        };
+
+        [[nodiscard]]
+        double elapsed_ns(benchmark_clock::time_point const start, benchmark_clock::time_point const end) {
+            return std::chrono::duration<double, std::nano>(end - start).count();
+        }
+
+        /// <summary>
+        /// nearest rank percentile of already sorted <paramref name="samples"/>
+        /// </summary>
+        [[nodiscard]]
+        double percentile(std::vector<double> const& samples, double const fraction) {
+            auto const rank = static_cast<std::size_t>(fraction * static_cast<double>(samples.size()));
+            return samples[std::min(rank, samples.size() - 1)];
+        }
+
+        [[nodiscard]]
+        latency_summary summarize(std::string scenario, unsigned int const threads, std::vector<double> samples) {
+            std::ranges::sort(samples);
+            latency_summary summary{std::move(scenario), threads, samples.size()};
+            if (samples.empty()) {
+                return summary;
+            }
+            summary.min_ns  = samples.front();
+            summary.mean_ns = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+            summary.p50_ns  = percentile(samples, 0.5);
+            summary.p99_ns  = percentile(samples, 0.99);
+            summary.p999_ns = percentile(samples, 0.999);
+            summary.max_ns  = samples.back();
+            return summary;
+        }
+
+        /// <summary>
+        /// times each of <paramref name="count"/> calls individually after <paramref name="warm_up_calls"/>
+        /// untimed calls
+        /// </summary>
+        template <typename Call>
+        [[nodiscard]]
+        std::vector<double> sample_calls(Call const& call, std::size_t const warm_up_calls, std::size_t const count) {
+            for (std::size_t i = 0; i < warm_up_calls; i++) {
+                do_not_optimize(call(static_cast<int>(i)));
+            }
+
+            std::vector<double> samples(count);
+            for (std::size_t i = 0; i < count; i++) {
+                auto const start  = benchmark_clock::now();
+                auto const result = call(static_cast<int>(i));
+                auto const end    = benchmark_clock::now();
+                do_not_optimize(result);
+                samples[i] = elapsed_ns(start, end);
+            }
+            return samples;
+        }
+
+        /// <summary>
+        /// measures <paramref name="call"/> in each scenario: the first call in the process, the first call on
+        /// a new thread, then warm calls from one and from <see cref="latency_options::threads"/> threads
+        /// </summary>
+        template <typename Call>
+        [[nodiscard]]
+        target_result measure_target(std::string name, Call const& call, latency_options const& options) {
+            target_result result{std::move(name), {}};
+
+            result.scenarios.push_back(summarize("cold_first_call", 1, sample_calls(call, 0, 1)));
+
+            std::vector<double> cold_thread_samples;
+            for (std::size_t i = 0; i < options.cold_threads; i++) {
+                std::thread([&] {
+                    auto const samples = sample_calls(call, 0, 1);
+                    cold_thread_samples.push_back(samples.front());
+                }).join();
+            }
+            result.scenarios.push_back(summarize("cold_thread_first_call", 1, std::move(cold_thread_samples)));
+
+            result.scenarios.push_back(
+                summarize("warm_single_thread", 1, sample_calls(call, options.warm_up_calls, options.samples)));
+
+            std::vector<std::vector<double>> per_thread_samples(options.threads);
+            std::barrier start_line{static_cast<std::ptrdiff_t>(options.threads)};
+            std::vector<std::thread> workers;
+            for (unsigned int t = 0; t < options.threads; t++) {
+                workers.emplace_back([&, t] {
+                    for (std::size_t i = 0; i < options.warm_up_calls; i++) {
+                        do_not_optimize(call(static_cast<int>(i)));
+                    }
+                    start_line.arrive_and_wait();
+                    per_thread_samples[t] = sample_calls(call, 0, options.samples);
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            std::vector<double> multi_thread_samples;
+            for (auto const& samples : per_thread_samples) {
+                multi_thread_samples.insert(multi_thread_samples.end(), samples.begin(), samples.end());
+            }
+            result.scenarios.push_back(
+                summarize("warm_multi_thread", options.threads, std::move(multi_thread_samples)));
+
+            return result;
+        }
+
+        [[nodiscard]]
+        latency_options parse_options(arguments const args) {
+            latency_options options{};
+            for (std::size_t i = 0; i < args.size(); i += 2) {
+                std::string_view const name{args[i]};
+                if (i + 1 == args.size()) {
+                    throw std::invalid_argument("missing value for " + std::string(name));
+                }
+                char const* const value = args[i + 1];
+                if (name == "--threads") {
+                    options.threads = std::max(1U, static_cast<unsigned int>(std::stoul(value)));
+                } else if (name == "--samples") {
+                    options.samples = std::max<std::size_t>(1, std::stoull(value));
+                } else if (name == "--cold-threads") {
+                    options.cold_threads = std::stoull(value);
+                } else if (name == "--dnne") {
+                    options.dnne_library = value;
+                } else if (name == "--output") {
+                    options.output = value;
+                } else {
+                    throw std::invalid_argument("unknown option " + std::string(name));
+                }
+            }
+            return options;
+        }
+
+        void write_json(std::FILE* const file, double const timer_overhead_ns, latency_options const& options,
+            std::vector<target_result> const& targets) {
+            char timestamp[32]{};
+            std::time_t const now = std::time(nullptr);
+            std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+            std::fprintf(file, "{\n");
+            std::fprintf(file, "  \"benchmark\": \"interop_latency\",\n");
+            std::fprintf(file, "  \"timestamp\": \"%s\",\n", timestamp);
+            std::fprintf(file, "  \"timer_overhead_ns\": %.2f,\n", timer_overhead_ns);
+            std::fprintf(file, "  \"samples_per_thread\": %zu,\n", options.samples);
+            std::fprintf(file, "  \"targets\": [\n");
+            for (std::size_t t = 0; t < targets.size(); t++) {
+                std::fprintf(file, "    {\n      \"name\": \"%s\",\n      \"scenarios\": [\n", targets[t].name.c_str());
+                auto const& scenarios = targets[t].scenarios;
+                for (std::size_t s = 0; s < scenarios.size(); s++) {
+                    auto const& summary = scenarios[s];
+                    std::fprintf(file,
+                        "        {\"name\": \"%s\", \"threads\": %u, \"samples\": %zu, \"min_ns\": %.2f, "
+                        "\"mean_ns\": %.2f, \"p50_ns\": %.2f, \"p99_ns\": %.2f, \"p99_9_ns\": %.2f, \"max_ns\": %.2f}%s\n",
+                        summary.scenario.c_str(), summary.threads, summary.samples, summary.min_ns, summary.mean_ns,
+                        summary.p50_ns, summary.p99_ns, summary.p999_ns, summary.max_ns,
+                        s + 1 < scenarios.size() ? "," : "");
+                }
+                std::fprintf(file, "      ]\n    }%s\n", t + 1 < targets.size() ? "," : "");
+            }
+            std::fprintf(file, "  ]\n}\n");
+        }
+    } // namespace
+
+    /// <summary>
+    /// per call latency of an inlined C++ baseline, the NativeAOT <c>add</c> export and, when given the path to
+    /// the DNNE generated library, <c>get_2x</c> and <c>get_dto</c>; written as JSON to stdout or --output
+    /// </summary>
+    /// <param name="args">
+    /// [--threads N] [--samples per thread] [--cold-threads N] [--dnne path to netframework_library] [--output file]
+    /// </param>
+    /// <remarks>
+    /// each sample includes one read of the clock, reported as timer_overhead_ns so it can be subtracted
+    /// when comparing against other measurements
+    /// </remarks>
+    int interop_latency_benchmark(arguments const args) {
+        latency_options options{};
+        try {
+            options = parse_options(args);
+        } catch (std::logic_error const& ex) {
+            // invalid_argument or out_of_range, from a bad option or from std::stoul on a bad value
+            std::fprintf(stderr,
+                "%s\nusage: interop_latency [--threads N] [--samples N] [--cold-threads N] [--dnne path] "
+                "[--output file]\n",
+                ex.what());
+            return 1;
+        }
+
+        std::vector<double> overhead = sample_calls([](int const i) { return i; }, options.warm_up_calls, options.samples);
+        std::ranges::sort(overhead);
+        double const timer_overhead_ns = percentile(overhead, 0.5);
+
+        std::vector<target_result> targets;
+
+        // constructing the calculator loads the library, the first call still pays for runtime start up
+        calculator const calc{};
+        targets.push_back(measure_target("native_aot_add", [&calc](int const i) { return calc.add(i, i); }, options));
+
+        if (options.dnne_library.has_value()) {
+            native_library const dnne{options.dnne_library->c_str()};
+            auto const get_2x  = dnne.resolve<int (*)(int)>("get_2x");
+            auto const get_dto = dnne.resolve<int (*)(int, DataTransferObject*)>("get_dto");
+
+            targets.push_back(measure_target("dnne_get_2x", [get_2x](int const i) { return get_2x(i); }, options));
+            targets.push_back(measure_target("dnne_get_dto",
+                [get_dto](int const i) {
+                    DataTransferObject dto{};
+                    return get_dto(i, &dto) + dto.isValid;
+                },
+                options));
+        }
+
+        auto const inline_2x = [](int const i) { return i + i; };
+        targets.push_back(measure_target("cpp_inline", inline_2x, options));
+
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> output{nullptr, std::fclose};
+        if (options.output.has_value()) {
+            output.reset(std::fopen(options.output->c_str(), "w"));
+            if (output == nullptr) {
+                throw std::runtime_error("Unable to open " + *options.output);
+            }
+        }
+        write_json(output != nullptr ? output.get() : stdout, timer_overhead_ns, options, targets);
+        return 0;
+    }
+
+} // namespace tsmoreland::samples::csharp_interop_aot::benchmarks
@@ -0,0 +1,15 @@
+#include "benchmark.h"
+
+namespace benchmarks = tsmoreland::samples::csharp_interop_aot::benchmarks;
+
+constexpr tsmoreland::benchmarks::benchmark_entry available_benchmarks[] = {
+    {"add_many", benchmarks::add_many_benchmark},
+    {"async_scaling", benchmarks::async_scaling_benchmark},
+    {"buffer_throughput", benchmarks::buffer_throughput_benchmark},
+    {"construction", benchmarks::construction_benchmark},
+    {"interop_latency", benchmarks::interop_latency_benchmark},
+};
+
+int main(int argc, char* argv[]) {
+    return tsmoreland::benchmarks::run_benchmark({argv, static_cast<std::size_t>(argc)}, available_benchmarks);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include <stdexcept>
+#include <string>
+
+namespace tsmoreland::samples::csharp_interop_aot::benchmarks {
+
+#if defined(_WIN32)
+    constexpr char const* aot_library_path = "TSMoreland.Samples.CSharpInteropAot.dll";
+#elif defined(__APPLE__)
+    constexpr char const* aot_library_path = "TSMoreland.Samples.CSharpInteropAot.dylib";
+#else
+    constexpr char const* aot_library_path = "TSMoreland.Samples.CSharpInteropAot.so";
+#endif
+
+    /// <summary>
+    /// minimal wrapper over LoadLibrary/dlopen for benchmarks that need to load a library outside of
+    /// <see cref="calculator"/>, libraries are never unloaded
+    /// </summary>
+    class native_library final {
+#ifdef _WIN32
+        HMODULE handle_{};
+#else
+        void* handle_{};
+#endif
+
+    public:
+        explicit native_library(char const* const path) {
+#ifdef _WIN32
+            handle_ = LoadLibraryA(path);
+#else
+            handle_ = dlopen(path, RTLD_LAZY);
+#endif
+            if (handle_ == nullptr) {
+                throw std::runtime_error(std::string("Unable to load ") + path);
+            }
+        }
+
+        template <typename Function>
+        [[nodiscard]]
+        Function resolve(char const* const name) const {
+#ifdef _WIN32
+            auto* const address = GetProcAddress(handle_, name);
+#else
+            auto* const address = dlsym(handle_, name);
+#endif
+            if (address == nullptr) {
+                throw std::runtime_error(std::string("Unable to load ") + name);
+            }
+            return reinterpret_cast<Function>(address);
+        }
+    };
+
+} // namespace tsmoreland::samples::csharp_interop_aot::benchmarks
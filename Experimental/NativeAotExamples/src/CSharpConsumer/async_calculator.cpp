@@ -0,0 +1,164 @@
+#include "async_calculator.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <latch>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "csharp_interop_aot.h"
+
+namespace tsmoreland::samples::csharp_interop_aot {
+
+    class async_calculator_impl final {
+        struct request {
+            int x;
+            int y;
+            std::promise<int> result;
+        };
+
+        calculator const calculator_{};
+        std::size_t const max_batch_size_;
+        std::mutex mutex_;
+        std::condition_variable requests_available_;
+        std::deque<request> requests_;
+        bool stopping_{false};
+        std::exception_ptr attach_error_;
+        std::vector<std::jthread> workers_;
+
+        void run_worker(std::latch& attached) {
+            // first call on a new thread attaches it to the runtime, done here so no request pays for it; a failure
+            // is handed to the constructor, which stops the workers and rethrows it
+            try {
+                static_cast<void>(calculator_.add(0, 0));
+            } catch (...) {
+                std::scoped_lock lock{mutex_};
+                if (attach_error_ == nullptr) {
+                    attach_error_ = std::current_exception();
+                }
+            }
+            attached.count_down();
+
+            std::vector<request> batch;
+            std::vector<int> x;
+            std::vector<int> y;
+            std::vector<int> sums;
+            batch.reserve(max_batch_size_);
+
+            while (true) {
+                {
+                    std::unique_lock lock{mutex_};
+                    requests_available_.wait(lock, [this] { return stopping_ || !requests_.empty(); });
+                    if (requests_.empty()) {
+                        return;
+                    }
+
+                    auto const count = std::min(requests_.size(), max_batch_size_);
+                    std::move(requests_.begin(), requests_.begin() + static_cast<std::ptrdiff_t>(count),
+                        std::back_inserter(batch));
+                    requests_.erase(requests_.begin(), requests_.begin() + static_cast<std::ptrdiff_t>(count));
+                }
+
+                complete(batch, x, y, sums);
+                batch.clear();
+            }
+        }
+
+        void complete(std::vector<request>& batch, std::vector<int>& x, std::vector<int>& y,
+            std::vector<int>& sums) const {
+            x.resize(batch.size());
+            y.resize(batch.size());
+            sums.resize(batch.size());
+            for (std::size_t i = 0; i < batch.size(); i++) {
+                x[i] = batch[i].x;
+                y[i] = batch[i].y;
+            }
+
+            try {
+                calculator_.add_many(x, y, sums);
+            } catch (...) {
+                auto const error = std::current_exception();
+                for (auto& pending : batch) {
+                    pending.result.set_exception(error);
+                }
+                return;
+            }
+
+            for (std::size_t i = 0; i < batch.size(); i++) {
+                batch[i].result.set_value(sums[i]);
+            }
+        }
+
+        /// <summary>
+        /// stops and joins the workers once every request already queued has been completed
+        /// </summary>
+        void stop() noexcept {
+            {
+                std::scoped_lock lock{mutex_};
+                stopping_ = true;
+            }
+            requests_available_.notify_all();
+            workers_.clear();
+        }
+
+    public:
+        async_calculator_impl(std::size_t const worker_count, std::size_t const max_batch_size)
+            : max_batch_size_{std::max<std::size_t>(1, max_batch_size)} {
+            auto const count = std::max<std::size_t>(1, worker_count);
+            std::latch attached{static_cast<std::ptrdiff_t>(count)};
+
+            // the destructor doesn't run if construction fails, the workers already started are stopped here
+            // before attached goes out of scope
+            try {
+                workers_.reserve(count);
+                for (std::size_t i = 0; i < count; i++) {
+                    workers_.emplace_back([this, &attached] { run_worker(attached); });
+                }
+            } catch (...) {
+                stop();
+                throw;
+            }
+            attached.wait();
+
+            // every worker has counted down, attach_error_ is no longer written
+            if (attach_error_ != nullptr) {
+                stop();
+                std::rethrow_exception(attach_error_);
+            }
+        }
+
+        ~async_calculator_impl() {
+            stop();
+        }
+
+        async_calculator_impl(async_calculator_impl const&)            = delete;
+        async_calculator_impl& operator=(async_calculator_impl const&) = delete;
+        async_calculator_impl(async_calculator_impl&&)                 = delete;
+        async_calculator_impl& operator=(async_calculator_impl&&)      = delete;
+
+        [[nodiscard]]
+        std::future<int> add_async(int const x, int const y) {
+            std::promise<int> promise;
+            auto future = promise.get_future();
+            {
+                std::scoped_lock lock{mutex_};
+                requests_.push_back({x, y, std::move(promise)});
+            }
+            requests_available_.notify_one();
+            return future;
+        }
+    };
+
+    async_calculator::async_calculator(std::size_t const worker_count, std::size_t const max_batch_size)
+        : impl_{new async_calculator_impl(worker_count, max_batch_size)} {}
+    async_calculator::~async_calculator() {
+        delete impl_;
+    }
+    std::future<int> async_calculator::add_async(int const x, int const y) const {
+        return impl_->add_async(x, y);
+    }
+
+} // namespace tsmoreland::samples::csharp_interop_aot
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <future>
+
+namespace tsmoreland::samples::csharp_interop_aot {
+
+    class async_calculator_impl;
+
+    /// <summary>
+    /// asynchronous front end to <see cref="calculator"/>, requests are queued and completed by a fixed pool of
+    /// worker threads which drain the queue in batches using a single <c>add_many</c> call per batch
+    /// </summary>
+    /// <remarks>
+    /// each worker makes a call into the library before the constructor returns so the one off cost of attaching
+    /// a new thread to the managed runtime is paid up front rather than by the first request.
+    /// </remarks>
+    class async_calculator final {
+        async_calculator_impl* impl_{};
+
+    public:
+        /// <param name="worker_count">number of worker threads, at least one worker is always started</param>
+        /// <param name="max_batch_size">maximum number of queued requests completed by a single call</param>
+        /// <exception cref="std::runtime_error">if the library or any of its exports can't be loaded</exception>
+        /// <exception cref="std::system_error">if a worker thread can't be started</exception>
+        /// <remarks>
+        /// if a worker can't be started, or its first call into the library throws, the workers already started are
+        /// stopped and the exception is rethrown
+        /// </remarks>
+        explicit async_calculator(std::size_t worker_count, std::size_t max_batch_size = 1024);
+
+        /// <summary>
+        /// stops the workers once every request already queued has been completed
+        /// </summary>
+        ~async_calculator();
+        async_calculator(async_calculator const&)            = delete;
+        async_calculator& operator=(async_calculator const&) = delete;
+        async_calculator(async_calculator&&)                 = delete;
+        async_calculator& operator=(async_calculator&&)      = delete;
+
+        /// <summary>
+        /// queues the addition of <paramref name="x"/> and <paramref name="y"/>
+        /// </summary>
+        /// <returns>future completed by a worker thread with the sum or the exception raised computing it</returns>
+        [[nodiscard]]
+        std::future<int> add_async(int x, int y) const;
+    };
+}
@@ -1,4 +1,5 @@
 #include "csharp_interop_aot.h"
+#include "export_binding.h"
 
 #if defined(_WIN32)
 #define PATH_TO_LIBRARY "TSMoreland.Samples.CSharpInteropAot.dll"
@@ -26,56 +27,274 @@
 #define F_OK    0
 #endif
 
-#include <memory>
-#include <exception>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <stdexcept>
+#include <string>
 
 namespace tsmoreland::samples::csharp_interop_aot {
 
     int call_sum_func(char* path, char const* const func_name, int a, int b);
 
 
-    void initialize_csharp_interop_aot() {
-        
-    }
-
-    class calculator_impl final {
-        using cs_add = int (*)(int, int);
-
-        cs_add add_{};
 #ifdef _WIN32
-        HINSTANCE handle_{};
+    using library_handle = HINSTANCE;
 #else
-        void* handle_{};
+    using library_handle = void*;
 #endif
+
+    class calculator_impl final {
+        // every export the consumer uses, all are resolved when the library is loaded and loading fails if any
+        // are missing so calls never need to check for a null function
+        using aot_exports = export_table<
+            bound_export<"add", int(int, int)>,
+            bound_export<"add_many", int(int const*, int const*, int*, int)>,
+            bound_export<"sum_buffer", int(int const*, int, long long*)>,
+            bound_export<"scale_buffer", int(int*, int, int)>,
+            bound_export<"to_upper_utf8", int(char*, int)>,
+            bound_export<"get_stats", int(int, export_stats*)>,
+            bound_export<"multiply", int(int, int)>,
+            bound_export<"call_count", int()>>;
+
+        aot_exports exports_;
+
+        // what warm_up left in the library's counters, subtracted so callers only see their own calls
+        int warm_up_multiply_calls_{};
+        calculator_stats warm_up_stats_{};
+
+        /// <summary>
+        /// exports take an int count so anything larger is sent in INT_MAX sized chunks, <paramref name="call"/>
+        /// is given the offset and size of each chunk and returns the export's result
+        /// </summary>
+        template <typename Call>
+        static void for_each_chunk(std::size_t const count, char const* const name, Call&& call) {
+            for (std::size_t offset = 0; offset < count;) {
+                auto const chunk = static_cast<int>(std::min<std::size_t>(count - offset, INT_MAX));
+                if (call(offset, chunk) != 0) {
+                    throw std::runtime_error(std::string(name) + " failed");
+                }
+                offset += static_cast<std::size_t>(chunk);
+            }
+        }
+
     public:
-        explicit calculator_impl(char const * const path) {
+        explicit calculator_impl(library_handle const handle)
+            : exports_{[handle](char const* const name) { return SYM_LOAD(handle, name); }} {}
+
+        [[nodiscard]]
+        int add(int const x, int const y) const {
+            return exports_.get<"add">()(x, y);
+        }
+
+        void add_many(int const* x, int const* y, int* result, std::size_t const count) const {
+            for_each_chunk(count, "add_many", [&](std::size_t const offset, int const chunk) {
+                return exports_.get<"add_many">()(x + offset, y + offset, result + offset, chunk);
+            });
+        }
+
+        [[nodiscard]]
+        long long sum(int const* values, std::size_t const count) const {
+            long long total = 0;
+            for_each_chunk(count, "sum_buffer", [&](std::size_t const offset, int const chunk) {
+                long long partial = 0;
+                int const status  = exports_.get<"sum_buffer">()(values + offset, chunk, &partial);
+                total += partial;
+                return status;
+            });
+            return total;
+        }
+
+        void scale(int* values, std::size_t const count, int const factor) const {
+            for_each_chunk(count, "scale_buffer", [&](std::size_t const offset, int const chunk) {
+                return exports_.get<"scale_buffer">()(values + offset, chunk, factor);
+            });
+        }
+
+        void to_upper_utf8(char* buffer, std::size_t const length) const {
+            for_each_chunk(length, "to_upper_utf8", [&](std::size_t const offset, int const chunk) {
+                return exports_.get<"to_upper_utf8">()(buffer + offset, chunk);
+            });
+        }
+
+        [[nodiscard]]
+        int multiply(int const x, int const y) const {
+            return exports_.get<"multiply">()(x, y);
+        }
+
+        [[nodiscard]]
+        int call_count() const {
+            return exports_.get<"call_count">()() - warm_up_multiply_calls_;
+        }
+
+        [[nodiscard]]
+        calculator_stats stats() const {
+            calculator_stats stats{};
+            for (std::size_t i = 0; i < calculator_export_count; i++) {
+                export_stats& current = stats.exports[i];
+                if (exports_.get<"get_stats">()(static_cast<int>(i), &current) != 0) {
+                    throw std::runtime_error("get_stats failed");
+                }
+
+                export_stats const& warm_up = warm_up_stats_.exports[i];
+                current.calls -= warm_up.calls;
+                current.total_ns -= warm_up.total_ns;
+                for (std::size_t bucket = 0; bucket < export_stats::latency_bucket_count; bucket++) {
+                    current.latency_histogram[bucket] -= warm_up.latency_histogram[bucket];
+                }
+            }
+            return stats;
+        }
+
+        /// <summary>
+        /// calls each export once with throwaway arguments, then takes the calls it made back out of
+        /// <see cref="call_count"/> and <see cref="stats"/>
+        /// </summary>
+        void warm_up() {
+            static_cast<void>(add(0, 0));
+
+            constexpr int values[] = {0};
+            int result[]           = {0};
+            add_many(values, values, result, 1);
+            static_cast<void>(sum(values, 1));
+            scale(result, 1, 1);
+
+            char text[] = {'a'};
+            to_upper_utf8(text, 1);
+            static_cast<void>(multiply(0, 0));
+            static_cast<void>(call_count());
+
+            // call_count first as reading it is itself recorded, get_stats isn't
+            warm_up_multiply_calls_ = call_count();
+            warm_up_stats_          = stats();
+        }
+    };
+
+    namespace {
+        template <typename Func>
+        auto timed(std::chrono::nanoseconds& elapsed, Func&& func) {
+            auto const start = std::chrono::steady_clock::now();
+            auto result      = func();
+            elapsed          = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            return result;
+        }
+
+        // used when a calculator is constructed before initialize_csharp_interop_aot, matching the original behaviour
+        constexpr initialize_options implicit_options{symbol_binding::lazy, false};
+
+        static_assert(sizeof(export_stats) == (2 + export_stats::latency_bucket_count) * sizeof(std::int64_t),
+            "export_stats must match the layout of ExportStats in Telemetry.cs");
+    } // namespace
+
+    /// <summary>
+    /// process wide owner of the loaded library and its resolved exports, every <see cref="calculator"/> borrows
+    /// from the single instance rather than loading the library itself
+    /// </summary>
+    class export_registry final {
+        // declared first as the remaining members record into it as they're initialized
+        startup_timings timings_{};
+        library_handle handle_{};
+        calculator_impl calculator_;
+
+        static inline std::atomic<export_registry const*> loaded_{nullptr};
+
+        static library_handle load_library(char const* const path, [[maybe_unused]] symbol_binding const binding) {
 #ifdef _WIN32
-            handle_ = LoadLibraryA(path);
+            library_handle const handle = LoadLibraryA(path);
 #else
-            handle_ = dlopen(path, RTLD_LAZY)
+            library_handle const handle = dlopen(path, binding == symbol_binding::eager ? RTLD_NOW : RTLD_LAZY);
 #endif
-            // CoreRT libraries do not support unloading
-            // See https://github.com/dotnet/corert/issues/7887
+            if (handle == nullptr) {
+                throw std::runtime_error("Unable to load library");
+            }
+            return handle;
+        }
 
-            auto* proc_address = SYM_LOAD(handle_, "add");
+        export_registry(char const* const path, initialize_options const& options)
+            : timings_{options.binding, {}, {}, {}},
+              handle_{timed(timings_.load, [&] { return load_library(path, options.binding); })},
+              calculator_{timed(timings_.bind, [this] { return calculator_impl{handle_}; })} {
 
-            add_ = reinterpret_cast<cs_add>(proc_address);
-            if (add_ == nullptr) {
-                throw std::exception("Unable to load add");
+            if (options.warm_up_exports) {
+                auto const start    = std::chrono::steady_clock::now();
+                calculator_.warm_up();
+                timings_.first_call = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start);
             }
+
+            loaded_.store(this, std::memory_order_release);
         }
-        
+
+    public:
+        // CoreRT libraries do not support unloading so the handle is deliberately never released
+        // See https://github.com/dotnet/corert/issues/7887
+        ~export_registry() = default;
+        export_registry(export_registry const&) = delete;
+        export_registry& operator=(export_registry const&) = delete;
+        export_registry(export_registry&&) = delete;
+        export_registry& operator=(export_registry&&) = delete;
+
+        /// <summary>
+        /// returns the registry, loading the library and resolving its exports on first use
+        /// </summary>
+        /// <remarks>
+        /// initialization of a function local static is thread safe and, once complete, only costs a check of the
+        /// guard variable so later calls take no lock and make no allocation.  If loading fails the exception is
+        /// propagated and the next call tries again.
+        /// </remarks>
+        /// <param name="options">used only by the call which loads the library</param>
         [[nodiscard]]
-        int add(int const x, int const y) const {
-            return add_(x, y);
+        static export_registry const& instance(initialize_options const& options) {
+            static export_registry const registry{PATH_TO_LIBRARY, options};
+            return registry;
+        }
+
+        /// <returns>the registry if the library has been loaded, otherwise nullptr</returns>
+        [[nodiscard]]
+        static export_registry const* loaded() noexcept {
+            return loaded_.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]]
+        calculator_impl const* calculator() const noexcept {
+            return &calculator_;
+        }
+
+        [[nodiscard]]
+        startup_timings const& timings() const noexcept {
+            return timings_;
         }
     };
 
+    void initialize_csharp_interop_aot(initialize_options const& options) {
+        static_cast<void>(export_registry::instance(options));
+    }
 
-    calculator::calculator() : impl_{new calculator_impl(PATH_TO_LIBRARY)} {}
-    calculator::~calculator() {
-        delete impl_;
+    std::optional<startup_timings> get_startup_timings() noexcept {
+        if (auto const* registry = export_registry::loaded(); registry != nullptr) {
+            return registry->timings();
+        }
+        return std::nullopt;
     }
+
+    std::int64_t export_stats::latency_percentile_ns(double const fraction) const noexcept {
+        if (calls <= 0) {
+            return 0;
+        }
+
+        auto const target    = static_cast<std::int64_t>(fraction * static_cast<double>(calls));
+        std::int64_t counted = 0;
+        for (std::size_t bucket = 0; bucket < latency_histogram.size(); bucket++) {
+            counted += latency_histogram[bucket];
+            if (counted > target) {
+                return std::int64_t{1} << (bucket + 1);
+            }
+        }
+        return std::int64_t{1} << latency_histogram.size();
+    }
+
+    calculator::calculator() : impl_{export_registry::instance(implicit_options).calculator()} {}
+    calculator::~calculator() = default;
     calculator::calculator(calculator&& other) noexcept : impl_{other.impl_} {
         other.impl_ = nullptr;
     }
@@ -84,11 +303,8 @@ namespace tsmoreland::samples::csharp_interop_aot {
             return *this;
         }
 
-        calculator_impl* previous = nullptr;
-        std::swap(previous, impl_);
-        std::swap(impl_, other.impl_);
-
-        delete previous;
+        impl_       = other.impl_;
+        other.impl_ = nullptr;
 
         return *this;
     }
@@ -97,8 +313,54 @@ namespace tsmoreland::samples::csharp_interop_aot {
             return impl_->add(x, y);
         }
 
-        throw std::exception("object has been released.");
+        throw std::runtime_error("object has been released.");
         
     }
+    void calculator::add_many(std::span<int const> const x, std::span<int const> const y, std::span<int> const result) const {
+        if (impl_ == nullptr) {
+            throw std::runtime_error("object has been released.");
+        }
+        if (x.size() != result.size() || y.size() != result.size()) {
+            throw std::invalid_argument("x, y and result must be the same size");
+        }
+
+        impl_->add_many(x.data(), y.data(), result.data(), result.size());
+    }
+    long long calculator::sum(std::span<int const> const values) const {
+        if (impl_ == nullptr) {
+            throw std::runtime_error("object has been released.");
+        }
+        return impl_->sum(values.data(), values.size());
+    }
+    void calculator::scale(std::span<int> const values, int const factor) const {
+        if (impl_ == nullptr) {
+            throw std::runtime_error("object has been released.");
+        }
+        impl_->scale(values.data(), values.size(), factor);
+    }
+    void calculator::to_upper_utf8(std::span<char> const utf8) const {
+        if (impl_ == nullptr) {
+            throw std::runtime_error("object has been released.");
+        }
+        impl_->to_upper_utf8(utf8.data(), utf8.size());
+    }
+    int calculator::multiply(int const x, int const y) const {
+        if (impl_ == nullptr) {
+            throw std::runtime_error("object has been released.");
+        }
+        return impl_->multiply(x, y);
+    }
+    int calculator::call_count() const {
+        if (impl_ == nullptr) {
+            throw std::runtime_error("object has been released.");
+        }
+        return impl_->call_count();
+    }
+    calculator_stats calculator::stats() const {
+        if (impl_ == nullptr) {
+            throw std::runtime_error("object has been released.");
+        }
+        return impl_->stats();
+    }
 
 } // namespace tsmoreland::samples::csharp_interop_aot
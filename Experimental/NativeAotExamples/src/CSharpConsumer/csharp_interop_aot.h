@@ -1,13 +1,118 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
 namespace tsmoreland::samples::csharp_interop_aot {
 
-    void initialize_csharp_interop_aot();
+    /// <summary>
+    /// when symbols imported by the library are bound, only meaningful where the library is loaded with dlopen
+    /// (<c>RTLD_LAZY</c> or <c>RTLD_NOW</c>) as LoadLibrary always binds imports at load
+    /// </summary>
+    enum class symbol_binding {
+        lazy,
+        eager,
+    };
+
+    struct initialize_options {
+        symbol_binding binding{symbol_binding::eager};
+
+        /// <summary>
+        /// call each export once during initialization so runtime start up and first call costs are paid there
+        /// </summary>
+        bool warm_up_exports{true};
+    };
+
+    /// <summary>
+    /// time spent in each phase of loading the library
+    /// </summary>
+    struct startup_timings {
+        symbol_binding binding{};
+        std::chrono::nanoseconds load{};
+        std::chrono::nanoseconds bind{};
+
+        /// <summary>
+        /// total time of the first call to each export, zero unless exports were warmed up
+        /// </summary>
+        std::chrono::nanoseconds first_call{};
+    };
+
+    /// <summary>
+    /// loads the library, resolves its exports and by default calls each of them once; optional as the first
+    /// <see cref="calculator"/> constructed will load the library (lazily bound and without warm up), but calling
+    /// it at startup keeps that cost off the first request.  Has no effect once the library is loaded.
+    /// </summary>
+    /// <exception cref="std::runtime_error">if the library or any of its exports can't be loaded</exception>
+    void initialize_csharp_interop_aot(initialize_options const& options = {});
+
+    /// <summary>
+    /// returns the startup phase timings recorded when the library was loaded
+    /// </summary>
+    /// <returns>the recorded timings, or an empty optional if the library hasn't been loaded</returns>
+    [[nodiscard]]
+    std::optional<startup_timings> get_startup_timings() noexcept;
+
+    /// <summary>
+    /// exports for which the library records statistics, values must match <c>Export</c> in Telemetry.cs
+    /// </summary>
+    enum class calculator_export {
+        add,
+        add_many,
+        sum_buffer,
+        scale_buffer,
+        to_upper_utf8,
+        multiply,
+        call_count,
+    };
+
+    inline constexpr std::size_t calculator_export_count = static_cast<std::size_t>(calculator_export::call_count) + 1;
+
+    /// <summary>
+    /// call count and latency of one export summed across every thread, layout must match <c>ExportStats</c>
+    /// in Telemetry.cs
+    /// </summary>
+    struct export_stats {
+        static constexpr std::size_t latency_bucket_count = 32;
+
+        std::int64_t calls{};
+        std::int64_t total_ns{};
+
+        /// <summary>
+        /// bucket <c>i</c> counts calls taking at least <c>2^i</c> and less than <c>2^(i + 1)</c> nanoseconds,
+        /// the last bucket also holds anything slower
+        /// </summary>
+        std::array<std::int64_t, latency_bucket_count> latency_histogram{};
+
+        /// <summary>
+        /// upper bound of the latency below which <paramref name="fraction"/> of calls completed, accurate to the
+        /// power of two width of the histogram buckets
+        /// </summary>
+        /// <returns>the bound in nanoseconds, or zero if there have been no calls</returns>
+        [[nodiscard]]
+        std::int64_t latency_percentile_ns(double fraction) const noexcept;
+    };
+
+    struct calculator_stats {
+        std::array<export_stats, calculator_export_count> exports{};
+
+        [[nodiscard]]
+        export_stats const& operator[](calculator_export const export_id) const noexcept {
+            return exports[static_cast<std::size_t>(export_id)];
+        }
+    };
 
     class calculator_impl;
 
+    /// <summary>
+    /// lightweight handle over the exports of the process wide library instance, construction neither loads
+    /// the library (beyond the first time) nor allocates
+    /// </summary>
     class calculator final {
-        calculator_impl* impl_{};
+        calculator_impl const* impl_{};
 
     public:
         explicit calculator();
@@ -19,6 +124,53 @@ namespace tsmoreland::samples::csharp_interop_aot {
         
         [[nodiscard]]
         int add(int const x, int const y) const;
+
+        /// <summary>
+        /// adds each pair <c>x[i] + y[i]</c> into <c>result[i]</c> using a single call into the library
+        /// rather than one call per pair
+        /// </summary>
+        /// <exception cref="std::invalid_argument">if x, y and result are not all the same size</exception>
+        void add_many(std::span<int const> x, std::span<int const> y, std::span<int> result) const;
+
+        // the buffer methods below pass the caller's memory straight through to the library, managed code reads
+        // and writes it in place so nothing is copied or marshaled in either direction
+
+        /// <summary>
+        /// returns the sum of <paramref name="values"/>
+        /// </summary>
+        [[nodiscard]]
+        long long sum(std::span<int const> values) const;
+
+        /// <summary>
+        /// multiplies each of <paramref name="values"/> by <paramref name="factor"/> in place
+        /// </summary>
+        void scale(std::span<int> values, int factor) const;
+
+        /// <summary>
+        /// converts the ASCII letters of a UTF-8 buffer to upper case in place; other characters are left as is
+        /// so the buffer stays valid UTF-8 of the same length
+        /// </summary>
+        void to_upper_utf8(std::span<char> utf8) const;
+
+        /// <summary>
+        /// multiplies using the calculator from TSMoreland.Samples.CSharpLibrary
+        /// </summary>
+        [[nodiscard]]
+        int multiply(int x, int y) const;
+
+        /// <summary>
+        /// returns the number of calls made to <see cref="multiply"/> across the process, other than by the warm up
+        /// </summary>
+        [[nodiscard]]
+        int call_count() const;
+
+        /// <summary>
+        /// returns the call counts and latencies the library has recorded for each export since it was loaded,
+        /// leaving out the calls made to warm it up; counters are read without stopping other threads so calls in
+        /// flight may or may not be included
+        /// </summary>
+        [[nodiscard]]
+        calculator_stats stats() const;
     };
 }
 
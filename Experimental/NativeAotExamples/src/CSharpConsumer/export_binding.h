@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace tsmoreland::samples::csharp_interop_aot {
+
+    /// <summary>
+    /// string literal usable as a template argument, holds the name of an export
+    /// </summary>
+    template <std::size_t Length>
+    struct fixed_string {
+        char value[Length]{};
+
+        constexpr fixed_string(char const (&text)[Length]) {
+            std::copy_n(text, Length, value);
+        }
+
+        [[nodiscard]]
+        constexpr std::string_view view() const noexcept {
+            return {value, Length - 1};
+        }
+    };
+
+    template <fixed_string Name, typename Signature>
+    class bound_export;
+
+    /// <summary>
+    /// the export <c>Name</c> of type <c>Result(Args...)</c>, once bound by an <see cref="export_table"/> a call
+    /// is a direct call through the function pointer
+    /// </summary>
+    template <fixed_string Name, typename Result, typename... Args>
+    class bound_export<Name, Result(Args...)> final {
+    public:
+        using pointer = Result (*)(Args...);
+
+        // null terminated as fixed_string keeps the terminator of the literal
+        static constexpr std::string_view name = Name.view();
+
+        constexpr bound_export() noexcept = default;
+        explicit bound_export(pointer const function) noexcept : function_{function} {}
+
+        Result operator()(Args... args) const {
+            return function_(args...);
+        }
+
+    private:
+        pointer function_{};
+    };
+
+    /// <summary>
+    /// a fixed set of <see cref="bound_export"/>s resolved together when the table is constructed, the set and
+    /// the lookup of each export by name are fixed at compile time
+    /// </summary>
+    template <typename... Exports>
+    class export_table final {
+        std::tuple<Exports...> exports_{};
+
+        static constexpr std::array<std::string_view, sizeof...(Exports)> names_{Exports::name...};
+
+        static consteval bool names_are_unique() {
+            for (std::size_t i = 0; i < names_.size(); i++) {
+                for (std::size_t j = i + 1; j < names_.size(); j++) {
+                    if (names_[i] == names_[j]) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+        static_assert(names_are_unique(), "each export may only appear once in the table");
+
+        template <fixed_string Name>
+        static consteval std::size_t index_of() {
+            return static_cast<std::size_t>(std::ranges::find(names_, Name.view()) - names_.begin());
+        }
+
+        template <typename Export, typename Resolver>
+        static Export bind(Resolver& resolve, std::string& missing) {
+            auto const address = resolve(Export::name.data());
+            if (address == nullptr) {
+                missing += missing.empty() ? "" : ", ";
+                missing += Export::name;
+                return Export{};
+            }
+            return Export{reinterpret_cast<typename Export::pointer>(address)};
+        }
+
+    public:
+        /// <summary>
+        /// binds every export using <paramref name="resolve"/>, which is given the null terminated name of an
+        /// export and returns its address or nullptr if the export isn't found
+        /// </summary>
+        /// <exception cref="std::runtime_error">naming every export which couldn't be resolved</exception>
+        template <typename Resolver>
+        explicit export_table(Resolver&& resolve) {
+            std::string missing;
+            exports_ = std::tuple<Exports...>{bind<Exports>(resolve, missing)...};
+            if (!missing.empty()) {
+                throw std::runtime_error("Unable to load " + missing);
+            }
+        }
+
+        template <fixed_string Name>
+        [[nodiscard]]
+        auto const& get() const noexcept {
+            constexpr std::size_t index = index_of<Name>();
+            static_assert(index < sizeof...(Exports), "the export is not in the table");
+            return std::get<index>(exports_);
+        }
+    };
+
+} // namespace tsmoreland::samples::csharp_interop_aot
@@ -2,15 +2,25 @@
 #include "csharp_interop_aot.h"
 
 using calculator = tsmoreland::samples::csharp_interop_aot::calculator;
+namespace csharp_interop_aot = tsmoreland::samples::csharp_interop_aot;
 
 int main() {
 
     try {
+        csharp_interop_aot::initialize_csharp_interop_aot();
+        if (auto const timings = csharp_interop_aot::get_startup_timings(); timings.has_value()) {
+            std::cout << "load: " << timings->load.count() << "ns, bind: " << timings->bind.count()
+                      << "ns, first call: " << timings->first_call.count() << "ns\n";
+        }
 
         calculator const calc{};
 
         int result = calc.add(1, 2);
         std::cout << result << "\n";
+        std::cout << calc.multiply(2, 3) << " (multiply calls: " << calc.call_count() << ")\n";
+
+        auto const add_stats = calc.stats()[csharp_interop_aot::calculator_export::add];
+        std::cout << "add calls: " << add_stats.calls << ", p99 < " << add_stats.latency_percentile_ns(0.99) << "ns\n";
     } catch (std::exception const& ex) {
         std::cout << ex.what() << "\n";
     }
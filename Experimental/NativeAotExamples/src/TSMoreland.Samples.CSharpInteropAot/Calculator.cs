@@ -1,10 +1,13 @@
-﻿using System.Runtime.InteropServices;
+﻿using System.Numerics;
+using System.Runtime.InteropServices;
 
 namespace TSMoreland.Samples.CSharpInteropAot;
 
 public sealed class Calculator
 {
-    private static Lazy<Calculator> s_calculator = new Lazy<Calculator>(() => new Calculator());
+    // created eagerly rather than through Lazy<T> so the exports don't pay for a thread safe check on every call,
+    // NativeAOT can pre-initialize the field at compile time as the constructor has no side effects
+    private static readonly Calculator s_calculator = new();
 
     public Calculator()
     {
@@ -15,9 +18,209 @@ public sealed class Calculator
         return x + y;
     }
 
+    public void AddMany(ReadOnlySpan<int> x, ReadOnlySpan<int> y, Span<int> result)
+    {
+        if (x.Length != result.Length || y.Length != result.Length)
+        {
+            throw new ArgumentException("x, y and result must have the same length");
+        }
+
+        int i = 0;
+        if (Vector.IsHardwareAccelerated)
+        {
+            for (; i <= result.Length - Vector<int>.Count; i += Vector<int>.Count)
+            {
+                (new Vector<int>(x.Slice(i)) + new Vector<int>(y.Slice(i))).CopyTo(result.Slice(i));
+            }
+        }
+
+        for (; i < result.Length; i++)
+        {
+            result[i] = x[i] + y[i];
+        }
+    }
+
+    public long Sum(ReadOnlySpan<int> values)
+    {
+        long total = 0;
+        foreach (int value in values)
+        {
+            total += value;
+        }
+        return total;
+    }
+
+    public void Scale(Span<int> values, int factor)
+    {
+        int i = 0;
+        if (Vector.IsHardwareAccelerated)
+        {
+            for (; i <= values.Length - Vector<int>.Count; i += Vector<int>.Count)
+            {
+                (new Vector<int>(values.Slice(i)) * factor).CopyTo(values.Slice(i));
+            }
+        }
+
+        for (; i < values.Length; i++)
+        {
+            values[i] *= factor;
+        }
+    }
+
+    /// <summary>
+    /// converts ASCII letters in <paramref name="utf8"/> to upper case in place, bytes of multi-byte sequences
+    /// are all 0x80 or above so are left untouched and the buffer remains valid UTF-8 of the same length
+    /// </summary>
+    public void ToUpperUtf8(Span<byte> utf8)
+    {
+        int i = 0;
+        if (Vector.IsHardwareAccelerated)
+        {
+            Vector<byte> lowerA = new((byte)'a');
+            Vector<byte> lowerZ = new((byte)'z');
+            Vector<byte> caseBit = new(0x20);
+            for (; i <= utf8.Length - Vector<byte>.Count; i += Vector<byte>.Count)
+            {
+                Vector<byte> chunk = new(utf8.Slice(i));
+                Vector<byte> isLower = Vector.GreaterThanOrEqual(chunk, lowerA) & Vector.LessThanOrEqual(chunk, lowerZ);
+                (chunk - (isLower & caseBit)).CopyTo(utf8.Slice(i));
+            }
+        }
+
+        for (; i < utf8.Length; i++)
+        {
+            if (utf8[i] is >= (byte)'a' and <= (byte)'z')
+            {
+                utf8[i] -= 0x20;
+            }
+        }
+    }
+
     [UnmanagedCallersOnly(EntryPoint = "add")]
     public static int NativeAdd(int x, int y)
     {
-        return s_calculator.Value.Add(x, y);
+        long start = Telemetry.Start();
+        try
+        {
+            return s_calculator.Add(x, y);
+        }
+        finally
+        {
+            Telemetry.Record(Export.Add, start);
+        }
+    }
+
+    /// <summary>
+    /// adds <paramref name="count"/> pairs of values in a single native to managed transition
+    /// </summary>
+    /// <returns>0 on success; -1 if any pointer is null or <paramref name="count"/> is negative</returns>
+    [UnmanagedCallersOnly(EntryPoint = "add_many")]
+    public static unsafe int NativeAddMany(int* x, int* y, int* result, int count)
+    {
+        long start = Telemetry.Start();
+        try
+        {
+            if (x == null || y == null || result == null || count < 0)
+            {
+                return -1;
+            }
+
+            s_calculator.AddMany(new ReadOnlySpan<int>(x, count), new ReadOnlySpan<int>(y, count), new Span<int>(result, count));
+            return 0;
+        }
+        finally
+        {
+            Telemetry.Record(Export.AddMany, start);
+        }
+    }
+
+    /// <summary>
+    /// sums <paramref name="count"/> values read directly from native memory
+    /// </summary>
+    /// <returns>0 on success; -1 if any pointer is null or <paramref name="count"/> is negative</returns>
+    [UnmanagedCallersOnly(EntryPoint = "sum_buffer")]
+    public static unsafe int NativeSumBuffer(int* values, int count, long* result)
+    {
+        long start = Telemetry.Start();
+        try
+        {
+            if (values == null || result == null || count < 0)
+            {
+                return -1;
+            }
+
+            *result = s_calculator.Sum(new ReadOnlySpan<int>(values, count));
+            return 0;
+        }
+        finally
+        {
+            Telemetry.Record(Export.SumBuffer, start);
+        }
+    }
+
+    /// <summary>
+    /// multiplies <paramref name="count"/> values by <paramref name="factor"/> in place in native memory
+    /// </summary>
+    /// <returns>0 on success; -1 if <paramref name="values"/> is null or <paramref name="count"/> is negative</returns>
+    [UnmanagedCallersOnly(EntryPoint = "scale_buffer")]
+    public static unsafe int NativeScaleBuffer(int* values, int count, int factor)
+    {
+        long start = Telemetry.Start();
+        try
+        {
+            if (values == null || count < 0)
+            {
+                return -1;
+            }
+
+            s_calculator.Scale(new Span<int>(values, count), factor);
+            return 0;
+        }
+        finally
+        {
+            Telemetry.Record(Export.ScaleBuffer, start);
+        }
+    }
+
+    /// <summary>
+    /// converts ASCII letters in a UTF-8 buffer to upper case in place in native memory
+    /// </summary>
+    /// <returns>0 on success; -1 if <paramref name="buffer"/> is null or <paramref name="length"/> is negative</returns>
+    [UnmanagedCallersOnly(EntryPoint = "to_upper_utf8")]
+    public static unsafe int NativeToUpperUtf8(byte* buffer, int length)
+    {
+        long start = Telemetry.Start();
+        try
+        {
+            if (buffer == null || length < 0)
+            {
+                return -1;
+            }
+
+            s_calculator.ToUpperUtf8(new Span<byte>(buffer, length));
+            return 0;
+        }
+        finally
+        {
+            Telemetry.Record(Export.ToUpperUtf8, start);
+        }
+    }
+
+    /// <summary>
+    /// fills <paramref name="stats"/> with the call count and latency histogram of an export summed across all
+    /// threads; calls to this export are not recorded
+    /// </summary>
+    /// <param name="export">one of the values of <see cref="Export"/></param>
+    /// <returns>0 on success; -1 if <paramref name="stats"/> is null or <paramref name="export"/> is unknown</returns>
+    [UnmanagedCallersOnly(EntryPoint = "get_stats")]
+    public static unsafe int NativeGetStats(int export, ExportStats* stats)
+    {
+        if (stats == null || !Telemetry.IsDefined(export))
+        {
+            return -1;
+        }
+
+        Telemetry.Read((Export)export, stats);
+        return 0;
     }
 }
\ No newline at end of file
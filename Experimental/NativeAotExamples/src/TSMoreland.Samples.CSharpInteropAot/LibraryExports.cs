@@ -0,0 +1,42 @@
+﻿using System.Runtime.InteropServices;
+using LibraryCalculator = TSMoreland.Samples.CSharpLibrary.Calculator;
+
+namespace TSMoreland.Samples.CSharpInteropAot;
+
+/// <summary>
+/// exports of the <see cref="LibraryCalculator"/> from TSMoreland.Samples.CSharpLibrary, which is compiled
+/// into this library rather than loaded separately
+/// </summary>
+public static class LibraryExports
+{
+    private static readonly LibraryCalculator s_calculator = new();
+
+    [UnmanagedCallersOnly(EntryPoint = "multiply")]
+    public static int NativeMultiply(int x, int y)
+    {
+        long start = Telemetry.Start();
+        try
+        {
+            return s_calculator.Multiply(x, y);
+        }
+        finally
+        {
+            Telemetry.Record(Export.Multiply, start);
+        }
+    }
+
+    /// <returns>the number of calls made to <c>multiply</c></returns>
+    [UnmanagedCallersOnly(EntryPoint = "call_count")]
+    public static int NativeCallCount()
+    {
+        long start = Telemetry.Start();
+        try
+        {
+            return s_calculator.CallCount();
+        }
+        finally
+        {
+            Telemetry.Record(Export.CallCount, start);
+        }
+    }
+}
\ No newline at end of file
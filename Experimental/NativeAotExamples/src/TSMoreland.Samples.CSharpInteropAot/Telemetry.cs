@@ -0,0 +1,130 @@
+﻿using System.Diagnostics;
+using System.Numerics;
+using System.Runtime.InteropServices;
+
+namespace TSMoreland.Samples.CSharpInteropAot;
+
+/// <summary>
+/// identifies an export in the statistics returned by <c>get_stats</c>, values must match
+/// <c>calculator_export</c> in csharp_interop_aot.h
+/// </summary>
+public enum Export
+{
+    Add,
+    AddMany,
+    SumBuffer,
+    ScaleBuffer,
+    ToUpperUtf8,
+    Multiply,
+    CallCount,
+}
+
+/// <summary>
+/// statistics of a single export, layout must match <c>export_stats</c> in csharp_interop_aot.h
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct ExportStats
+{
+    public const int LatencyBucketCount = 32;
+
+    public long Calls;
+    public long TotalNanoseconds;
+
+    /// <summary>
+    /// bucket <c>i</c> counts calls taking less than <c>2^(i + 1)</c> nanoseconds and at least <c>2^i</c>
+    /// (bucket 0 includes calls under 1ns), the last bucket also holds anything slower
+    /// </summary>
+    public fixed long LatencyHistogram[LatencyBucketCount];
+}
+
+/// <summary>
+/// per thread call counts and latency histograms of each export
+/// </summary>
+/// <remarks>
+/// each thread records into its own slot so the hot path takes no lock and makes no interlocked operation,
+/// only the owning thread writes to a slot and readers sum over all slots.  Slots are registered once per thread
+/// with a compare exchange onto a list which is never shrunk so counts from threads which have exited are kept.
+/// </remarks>
+internal static class Telemetry
+{
+    private const int ExportCount = (int)Export.CallCount + 1;
+
+    private static readonly double s_nanosecondsPerTick = 1_000_000_000.0 / Stopwatch.Frequency;
+    private static ThreadSlot? s_slots;
+
+    [ThreadStatic]
+    private static ThreadSlot? t_slot;
+
+    private sealed class ThreadSlot
+    {
+        public readonly long[] Calls = new long[ExportCount];
+        public readonly long[] TotalNanoseconds = new long[ExportCount];
+        public readonly long[] LatencyHistogram = new long[ExportCount * ExportStats.LatencyBucketCount];
+        public ThreadSlot? Next;
+    }
+
+    public static long Start()
+    {
+        return Stopwatch.GetTimestamp();
+    }
+
+    /// <summary>
+    /// records a call to <paramref name="export"/> which began at <paramref name="startTimestamp"/>
+    /// </summary>
+    public static void Record(Export export, long startTimestamp)
+    {
+        long nanoseconds = (long)((Stopwatch.GetTimestamp() - startTimestamp) * s_nanosecondsPerTick);
+        int bucket = Math.Min(BitOperations.Log2((ulong)Math.Max(nanoseconds, 1)), ExportStats.LatencyBucketCount - 1);
+
+        ThreadSlot slot = t_slot ?? Register();
+        int index = (int)export;
+
+        // single writer, volatile writes only so readers on other threads never see a torn 64-bit value
+        Volatile.Write(ref slot.Calls[index], slot.Calls[index] + 1);
+        Volatile.Write(ref slot.TotalNanoseconds[index], slot.TotalNanoseconds[index] + nanoseconds);
+        ref long count = ref slot.LatencyHistogram[index * ExportStats.LatencyBucketCount + bucket];
+        Volatile.Write(ref count, count + 1);
+    }
+
+    /// <summary>
+    /// sums the statistics of <paramref name="export"/> across every thread which has called into the library
+    /// </summary>
+    /// <remarks>
+    /// counters are read one at a time while other threads may be recording, so the result is a close rather
+    /// than exact snapshot
+    /// </remarks>
+    public static unsafe void Read(Export export, ExportStats* stats)
+    {
+        int index = (int)export;
+        *stats = default;
+        for (ThreadSlot? slot = Volatile.Read(ref s_slots); slot != null; slot = slot.Next)
+        {
+            stats->Calls += Volatile.Read(ref slot.Calls[index]);
+            stats->TotalNanoseconds += Volatile.Read(ref slot.TotalNanoseconds[index]);
+            for (int bucket = 0; bucket < ExportStats.LatencyBucketCount; bucket++)
+            {
+                stats->LatencyHistogram[bucket] += Volatile.Read(ref slot.LatencyHistogram[index * ExportStats.LatencyBucketCount + bucket]);
+            }
+        }
+    }
+
+    public static bool IsDefined(int export)
+    {
+        return export is >= 0 and < ExportCount;
+    }
+
+    private static ThreadSlot Register()
+    {
+        ThreadSlot slot = new();
+        ThreadSlot? head;
+        do
+        {
+            head = Volatile.Read(ref s_slots);
+            slot.Next = head;
+        }
+        while (Interlocked.CompareExchange(ref s_slots, slot, head) != head);
+
+        t_slot = slot;
+        return slot;
+    }
+}
\ No newline at end of file
@@ -19,12 +19,12 @@ public sealed class Calculator
 
     public int Multiply(int x, int y)
     {
-        _callcount++;
+        Interlocked.Increment(ref _callcount);
         return x*y;
     }
 
     public int CallCount()
     {
-        return _callcount;
+        return Volatile.Read(ref _callcount);
     }
 }
@@ -15,7 +15,126 @@
 //
 
 #include "pch.h"
+
 #include "SimpleObject.h"
+#include "TSMoreland.Interop.Portable/dispatch_table.h"
+#include "TSMoreland.Interop.Portable/guid.h"
+#include "TSMoreland.Interop.Portable/server_methods.h"
+#include "TSMoreland.Interop.Portable/string_allocator.h"
+
+using namespace tsmoreland::interop::literals;
+using tsmoreland::interop::convert_each;
+using tsmoreland::interop::copy_bstr;
+using tsmoreland::interop::upper_case_bstr;
+
+namespace {
+    /// <summary>
+    /// the methods that allocate strings, in the order GetStringStatistics reports them
+    /// </summary>
+    enum class string_method {
+        get_Name,
+        get_Description,
+        ConvertToString,
+        ConvertManyToString,
+        ToUpper,
+        ToUpperMany,
+        OnPropertyChanaged,
+        GetState,
+        count,
+    };
+
+    constexpr std::array<std::wstring_view, static_cast<std::size_t>(string_method::count)> string_method_names{
+        L"get_Name",
+        L"get_Description",
+        L"ConvertToString",
+        L"ConvertManyToString",
+        L"ToUpper",
+        L"ToUpperMany",
+        L"OnPropertyChanaged",
+        L"GetState",
+    };
+
+    using bstr_allocator = tsmoreland::interop::bstr_allocator<string_method>;
+
+    [[nodiscard]]
+    bstr_allocator& strings() noexcept {
+        static bstr_allocator allocator;
+        return allocator;
+    }
+
+    // the id is parsed at compile time, an invalid id fails the build
+    constexpr tsmoreland::interop::immutable_properties properties{
+        L"Simple Name",
+        tsmoreland::interop::to_win32("E3FF39CC-D456-4A43-A799-8B19A6139908"_guid),
+        L"Simple Description",
+    };
+
+    constexpr std::wstring_view numeric_property = L"Numeric";
+
+    /// <summary>
+    /// formats <paramref name="input"/> straight into a single BSTR allocation
+    /// </summary>
+    HRESULT format_bstr(string_method const method, GUID const& input, BSTR* result) noexcept {
+        using tsmoreland::interop::guid_string_length;
+
+        BSTR const text = strings().allocate(method, static_cast<std::uint32_t>(guid_string_length));
+        if (text == nullptr) {
+            return E_OUTOFMEMORY;
+        }
+        tsmoreland::interop::format_guid(
+            tsmoreland::interop::from_win32(input), std::span<wchar_t, guid_string_length>{text, guid_string_length});
+
+        *result = text;
+        return S_OK;
+    }
+
+    /// <summary>
+    /// DISPID of each member, as declared in the IDL
+    /// </summary>
+    namespace dispid {
+        constexpr DISPID name                     = 1;
+        constexpr DISPID numeric                  = 2;
+        constexpr DISPID id                       = 3;
+        constexpr DISPID convert_to_string        = 4;
+        constexpr DISPID description              = 5;
+        constexpr DISPID to_upper                 = 6;
+        constexpr DISPID to_upper_many            = 7;
+        constexpr DISPID convert_many_to_string   = 8;
+        constexpr DISPID async_events             = 9;
+        constexpr DISPID get_event_statistics     = 10;
+        constexpr DISPID add_numeric              = 11;
+        constexpr DISPID compare_exchange_numeric = 12;
+        constexpr DISPID get_string_statistics    = 13;
+        constexpr DISPID get_state                = 14;
+    } // namespace dispid
+
+    constexpr tsmoreland::interop::common_dispids common_members{
+        .name                     = dispid::name,
+        .numeric                  = dispid::numeric,
+        .description              = dispid::description,
+        .to_upper                 = dispid::to_upper,
+        .async_events             = dispid::async_events,
+        .add_numeric              = dispid::add_numeric,
+        .compare_exchange_numeric = dispid::compare_exchange_numeric,
+    };
+
+    constexpr tsmoreland::interop::perfect_hash_map dispatch_names{std::array<tsmoreland::interop::dispatch_name, 14>{{
+        {L"Name", dispid::name},
+        {L"Numeric", dispid::numeric},
+        {L"Id", dispid::id},
+        {L"ConvertToString", dispid::convert_to_string},
+        {L"Description", dispid::description},
+        {L"ToUpper", dispid::to_upper},
+        {L"ToUpperMany", dispid::to_upper_many},
+        {L"ConvertManyToString", dispid::convert_many_to_string},
+        {L"AsyncEvents", dispid::async_events},
+        {L"GetEventStatistics", dispid::get_event_statistics},
+        {L"AddNumeric", dispid::add_numeric},
+        {L"CompareExchangeNumeric", dispid::compare_exchange_numeric},
+        {L"GetStringStatistics", dispid::get_string_statistics},
+        {L"GetState", dispid::get_state},
+    }}};
+} // namespace
 
 
 
@@ -29,7 +148,10 @@ HRESULT CSimpleObject::FinalConstruct() {
 
 // ReSharper disable once CppInconsistentNaming
 // ReSharper disable once CppMemberFunctionMayBeStatic
-void CSimpleObject::FinalRelease() {}
+void CSimpleObject::FinalRelease() {
+    // delivers any queued events while the object is still whole
+    EnableAsyncEvents(false);
+}
 
 STDMETHODIMP CSimpleObject::get_Id(GUID* result) noexcept {
 
@@ -37,18 +159,8 @@ STDMETHODIMP CSimpleObject::get_Id(GUID* result) noexcept {
         return E_INVALIDARG;
     }
 
-    constexpr auto source = "E3FF39CC-D456-4A43-A799-8B19A6139908";
-    auto const uuid       = std::make_unique<char[]>(64);
-    strcpy_s(uuid.get(), 64, source);
-
-    if (GUID id{}; RPC_S_OK == UuidFromStringA(reinterpret_cast<RPC_CSTR>(uuid.get()), &id)) {
-        *result = id;
-        return S_OK;
-    }
-
-    *result = GUID{};
-
-    return E_FAIL;
+    *result = properties.id;
+    return S_OK;
 }
 
 STDMETHODIMP CSimpleObject::get_Name(BSTR* result) noexcept {
@@ -57,10 +169,7 @@ STDMETHODIMP CSimpleObject::get_Name(BSTR* result) noexcept {
         return E_INVALIDARG;
     }
 
-    CComBSTR value(L"Simple Name");
-    *result = value.Detach();
-
-    return S_OK;
+    return copy_bstr(strings(), string_method::get_Name, properties.name, result);
 }
 
 STDMETHODIMP CSimpleObject::get_Numeric(LONG* result) noexcept {
@@ -69,15 +178,16 @@ STDMETHODIMP CSimpleObject::get_Numeric(LONG* result) noexcept {
         return E_INVALIDARG;
     }
 
-    *result = numeric_;
+    *result = numeric_.load(std::memory_order_acquire);
     return S_OK;
 }
 
 STDMETHODIMP CSimpleObject::put_Numeric(LONG value) noexcept {
 
-    numeric_ = value;
+    numeric_.store(value, std::memory_order_release);
 
-    Fire_OnPropertyChanaged(CComBSTR{L"Numeric"}.Detach());
+    version_.fetch_add(1, std::memory_order_release);
+    Post_OnPropertyChanaged(strings().intern(string_method::OnPropertyChanaged, numeric_property));
 
     return S_OK;
 }
@@ -88,40 +198,136 @@ STDMETHODIMP CSimpleObject::ConvertToString(GUID input, BSTR* result) noexcept {
         return E_INVALIDARG;
     }
 
-    wchar_t* stringified{};
-    if (RPC_S_OK != UuidToStringW(&input, reinterpret_cast<RPC_WSTR*>(&stringified))) {
-        return E_FAIL;
+    return format_bstr(string_method::ConvertToString, input, result);
+}
+
+STDMETHODIMP CSimpleObject::get_Description(BSTR* result) noexcept {
+
+    if (result == nullptr) {
+        return E_INVALIDARG;
     }
 
-    // will this copy the string or do I need to?  time will tell, that or google
-    CComBSTR output{stringified};
-    *result = output.Detach();
+    return copy_bstr(strings(), string_method::get_Description, properties.description, result);
+}
 
-    RpcStringFreeW(reinterpret_cast<RPC_WSTR*>(&stringified));
-    return S_OK;
+STDMETHODIMP CSimpleObject::ToUpper(BSTR input, BSTR* result) noexcept {
+    if (input == nullptr || result == nullptr) {
+        return E_INVALIDARG;
+    }
+
+    return upper_case_bstr(strings(), string_method::ToUpper, input, result);
 }
 
-STDMETHODIMP CSimpleObject::get_Description(BSTR* result) noexcept {
+STDMETHODIMP CSimpleObject::ToUpperMany(SAFEARRAY* inputs, SAFEARRAY** results) noexcept {
+    return convert_each<BSTR>(inputs, VT_BSTR, results, [](BSTR const input, BSTR* result) noexcept {
+        return upper_case_bstr(strings(), string_method::ToUpperMany, input, result);
+    });
+}
+
+STDMETHODIMP CSimpleObject::ConvertManyToString(SAFEARRAY* inputs, SAFEARRAY** results) noexcept {
+    return convert_each<UDTGuid>(inputs, VT_RECORD, results, [](UDTGuid const& input, BSTR* result) noexcept {
+        static_assert(sizeof(UDTGuid) == sizeof(GUID), "UDTGuid must share the layout of GUID");
+        GUID id{};
+        std::memcpy(&id, &input, sizeof(id));
+        return format_bstr(string_method::ConvertManyToString, id, result);
+    });
+}
 
+STDMETHODIMP CSimpleObject::get_AsyncEvents(VARIANT_BOOL* result) noexcept {
     if (result == nullptr) {
         return E_INVALIDARG;
     }
 
-    CComBSTR value(L"Simple Description");
-    *result = value.Detach();
+    *result = AsyncEventsEnabled() ? VARIANT_TRUE : VARIANT_FALSE;
+    return S_OK;
+}
 
+STDMETHODIMP CSimpleObject::put_AsyncEvents(VARIANT_BOOL value) noexcept {
+    return EnableAsyncEvents(value != VARIANT_FALSE);
+}
+
+STDMETHODIMP CSimpleObject::GetEventStatistics(LONG* queueDepth, LONGLONG* coalesced, LONGLONG* dropped) noexcept {
+    if (queueDepth == nullptr || coalesced == nullptr || dropped == nullptr) {
+        return E_INVALIDARG;
+    }
+
+    try {
+        auto const statistics = AsyncEventStatistics();
+        *queueDepth           = static_cast<LONG>(statistics.queue_depth);
+        *coalesced            = static_cast<LONGLONG>(statistics.coalesced);
+        *dropped              = static_cast<LONGLONG>(statistics.dropped);
+    } catch (std::system_error const&) {
+        return E_FAIL;
+    }
     return S_OK;
 }
 
-STDMETHODIMP CSimpleObject::ToUpper(BSTR input, BSTR* result) noexcept {
-    if (input == nullptr || result == nullptr) {
+STDMETHODIMP CSimpleObject::AddNumeric(LONG delta, LONG* result) noexcept {
+    if (result == nullptr) {
         return E_INVALIDARG;
     }
 
-    std::wstring upper{input};
-    std::ranges::for_each(upper, [](wchar_t& ch) { ch = ::towupper(ch); });
+    // fetch_add on a signed atomic wraps rather than overflowing, the new value is computed unsigned to match
+    LONG const previous = numeric_.fetch_add(delta, std::memory_order_acq_rel);
+    *result             = static_cast<LONG>(static_cast<ULONG>(previous) + static_cast<ULONG>(delta));
+    if (delta != 0) {
+        version_.fetch_add(1, std::memory_order_release);
+        Post_OnPropertyChanaged(strings().intern(string_method::OnPropertyChanaged, numeric_property));
+    }
+    return S_OK;
+}
 
-    CComBSTR output{upper.c_str()};
-    *result = output.Detach();
+STDMETHODIMP CSimpleObject::CompareExchangeNumeric(LONG value, LONG comparand, LONG* result) noexcept {
+    if (result == nullptr) {
+        return E_INVALIDARG;
+    }
+
+    LONG original = comparand;
+    if (numeric_.compare_exchange_strong(original, value, std::memory_order_acq_rel, std::memory_order_acquire) &&
+        value != comparand) {
+        version_.fetch_add(1, std::memory_order_release);
+        Post_OnPropertyChanaged(strings().intern(string_method::OnPropertyChanaged, numeric_property));
+    }
+    *result = original;
     return S_OK;
 }
+
+STDMETHODIMP CSimpleObject::GetStringStatistics(
+    SAFEARRAY** methods, SAFEARRAY** allocations, SAFEARRAY** bytes) noexcept {
+    return tsmoreland::interop::string_statistics(strings(), string_method_names, methods, allocations, bytes);
+}
+
+STDMETHODIMP CSimpleObject::GetState(LONGLONG knownVersion, SimpleObjectState* state, VARIANT_BOOL* changed) noexcept {
+    return tsmoreland::interop::read_state(
+        strings(), string_method::GetState, properties, version_, numeric_, knownVersion, state, changed);
+}
+
+STDMETHODIMP CSimpleObject::GetIDsOfNames(REFIID riid, LPOLESTR* names, UINT count, LCID lcid, DISPID* ids) {
+    if (!::InlineIsEqualGUID(riid, IID_NULL)) {
+        return DISP_E_UNKNOWNINTERFACE;
+    }
+    if (count != 1 || names == nullptr || names[0] == nullptr || ids == nullptr) {
+        return dispatch_base::GetIDsOfNames(riid, names, count, lcid, ids);
+    }
+
+    // the table holds every member, a name it doesn't have isn't one
+    auto const id = dispatch_names.find(names[0]);
+    ids[0]        = id.value_or(DISPID_UNKNOWN);
+    return id.has_value() ? S_OK : DISP_E_UNKNOWNNAME;
+}
+
+STDMETHODIMP CSimpleObject::Invoke(DISPID id, REFIID riid, LCID lcid, WORD flags, DISPPARAMS* params,
+    VARIANT* result, EXCEPINFO* exception, UINT* argument_error) {
+    if (!::InlineIsEqualGUID(riid, IID_NULL)) {
+        return DISP_E_UNKNOWNINTERFACE;
+    }
+    if (params != nullptr) {
+        tsmoreland::interop::dispatch_call const call{flags, *params};
+        if (auto const hr = tsmoreland::interop::invoke_common_member<common_members>(
+                *this, id, call, result, exception, argument_error);
+            hr.has_value()) {
+            return *hr;
+        }
+    }
+    return dispatch_base::Invoke(id, riid, lcid, flags, params, result, exception, argument_error);
+}
@@ -32,8 +32,13 @@ class ATL_NO_VTABLE CSimpleObject : public CComObjectRootEx<CComMultiThreadModel
                                     public CComCoClass<CSimpleObject, &CLSID_SimpleObject>,
                                     public IConnectionPointContainerImpl<CSimpleObject>,
                                     public CProxy_ISimpleObjectEvents<CSimpleObject>,
-                                    public IDispatchImpl<ISimpleObject2, &IID_ISimpleObject2, &LIBID_SimpleInProcessCOMLib, /*wMajor =*/1, /*wMinor =*/0> {
-    LONG numeric_{0};
+                                    public IDispatchImpl<ISimpleObject3, &IID_ISimpleObject3, &LIBID_SimpleInProcessCOMLib, /*wMajor =*/1, /*wMinor =*/0> {
+    std::atomic<LONG> numeric_{0};
+    // incremented after every change to numeric_, see GetState
+    std::atomic<LONGLONG> version_{1};
+
+    using dispatch_base =
+        IDispatchImpl<ISimpleObject3, &IID_ISimpleObject3, &LIBID_SimpleInProcessCOMLib, /*wMajor =*/1, /*wMinor =*/0>;
 
 public:
 
@@ -67,8 +72,7 @@ public:
     /// </summary>
     /// <param name="result">on success stores the id</param>
     /// <returns>
-    /// S_OK on success, otherwise either E_INVALIDARG if <paramref name="result"/> is nullptr
-    /// or E_FAIL if unable to create GUID
+    /// S_OK on success, otherwise E_INVALIDARG if <paramref name="result"/> is nullptr
     /// </returns>
     STDMETHOD(get_Id)(GUID* result) noexcept override;
 
@@ -77,7 +81,10 @@ public:
     /// </summary>
     /// <param name="input">GUID to convert</param>
     /// <param name="result">on success stores the string representation</param>
-    /// <returns>S_OK on success; otherwise, E_INVALIDARG if result is nullptr, and E_FAIL for any other failure</returns>
+    /// <returns>
+    /// S_OK on success; otherwise, E_INVALIDARG if result is nullptr, or E_OUTOFMEMORY if the result can't be
+    /// allocated
+    /// </returns>
     STDMETHOD(ConvertToString)(GUID input, BSTR* result) noexcept override;
 
 
@@ -95,9 +102,147 @@ public:
     /// </summary>
     /// <param name="input">source to convert</param>
     /// <param name="result">stores the upper case result</param>
-    /// <returns>S_OK on success; otherwise E_INVALIDARG if input is a nullptr</returns>
+    /// <returns>
+    /// S_OK on success; otherwise E_INVALIDARG if input is a nullptr or E_OUTOFMEMORY if the result can't be allocated
+    /// </returns>
     STDMETHOD(ToUpper)(BSTR input, BSTR* result) noexcept override;
 
+    /// <summary>
+    /// Convert each string of <paramref name="inputs"/> to upper case, as <see cref="ToUpper"/>, in a single call
+    /// </summary>
+    /// <param name="inputs">one dimensional array of strings to convert, null elements are treated as empty</param>
+    /// <param name="results">
+    /// on success stores a new array with the same bounds holding the upper case form of each input
+    /// </param>
+    /// <returns>
+    /// S_OK on success; otherwise E_INVALIDARG if either argument is a nullptr or <paramref name="inputs"/> isn't
+    /// a one dimensional array of BSTR, or E_OUTOFMEMORY if the results can't be allocated
+    /// </returns>
+    STDMETHOD(ToUpperMany)(SAFEARRAY* inputs, SAFEARRAY** results) noexcept override;
+
+    /// <summary>
+    /// Returns the string representation of each GUID of <paramref name="inputs"/>, as
+    /// <see cref="ConvertToString"/>, in a single call
+    /// </summary>
+    /// <param name="inputs">
+    /// one dimensional array of UDTGuid, Data4 holds the 8 bytes of GUID::Data4 in memory order
+    /// </param>
+    /// <param name="results">
+    /// on success stores a new array with the same bounds holding the string representation of each input
+    /// </param>
+    /// <returns>
+    /// S_OK on success; otherwise E_INVALIDARG if either argument is a nullptr or <paramref name="inputs"/> isn't
+    /// a one dimensional array of UDTGuid, or E_OUTOFMEMORY if the results can't be allocated
+    /// </returns>
+    STDMETHOD(ConvertManyToString)(SAFEARRAY* inputs, SAFEARRAY** results) noexcept override;
+
+    /// <summary>
+    /// returns whether property change events are delivered asynchronously
+    /// </summary>
+    /// <param name="result">on success stores VARIANT_TRUE if events are asynchronous, otherwise VARIANT_FALSE</param>
+    /// <returns>
+    /// S_OK on success, otherwise E_INVALIDARG if <paramref name="result"/> is nullptr
+    /// </returns>
+    STDMETHOD(get_AsyncEvents)(VARIANT_BOOL* result) noexcept override;
+
+    /// <summary>
+    /// switches property change events between delivery on the writing thread and delivery from a dispatcher
+    /// thread, which coalesces repeated changes to a property not yet delivered and drops changes once too many
+    /// properties are waiting
+    /// </summary>
+    /// <param name="value">
+    /// VARIANT_TRUE to deliver asynchronously, VARIANT_FALSE to deliver the queued events and return to synchronous
+    /// delivery
+    /// </param>
+    /// <returns>
+    /// S_OK on success; otherwise E_ILLEGAL_METHOD_CALL if enabling while the object lives in a single threaded
+    /// apartment, E_OUTOFMEMORY if the dispatcher can't be allocated or E_FAIL if its thread can't be started
+    /// </returns>
+    STDMETHOD(put_AsyncEvents)(VARIANT_BOOL value) noexcept override;
+
+    /// <summary>
+    /// returns the counters of asynchronous event delivery since it was last enabled, all 0 while it's disabled
+    /// </summary>
+    /// <param name="queueDepth">on success stores the number of properties waiting for delivery</param>
+    /// <param name="coalesced">on success stores the number of changes merged with one already waiting</param>
+    /// <param name="dropped">on success stores the number of changes dropped because the queue was full</param>
+    /// <returns>
+    /// S_OK on success, otherwise E_INVALIDARG if any argument is nullptr
+    /// </returns>
+    STDMETHOD(GetEventStatistics)(LONG* queueDepth, LONGLONG* coalesced, LONGLONG* dropped) noexcept override;
+
+    /// <summary>
+    /// adds <paramref name="delta"/> to the numeric value in one atomic step, wrapping on overflow
+    /// </summary>
+    /// <param name="delta">amount to add, may be negative</param>
+    /// <param name="result">on success stores the numeric value after the addition</param>
+    /// <returns>
+    /// S_OK on success, otherwise E_INVALIDARG if <paramref name="result"/> is nullptr
+    /// </returns>
+    STDMETHOD(AddNumeric)(LONG delta, LONG* result) noexcept override;
+
+    /// <summary>
+    /// sets the numeric value to <paramref name="value"/> if it currently equals <paramref name="comparand"/>, in
+    /// one atomic step as InterlockedCompareExchange
+    /// </summary>
+    /// <param name="value">value to store</param>
+    /// <param name="comparand">value the numeric value must hold for <paramref name="value"/> to be stored</param>
+    /// <param name="result">
+    /// on success stores the numeric value before the call, equal to <paramref name="comparand"/> if it was replaced
+    /// </param>
+    /// <returns>
+    /// S_OK on success, otherwise E_INVALIDARG if <paramref name="result"/> is nullptr
+    /// </returns>
+    STDMETHOD(CompareExchangeNumeric)(LONG value, LONG comparand, LONG* result) noexcept override;
+
+    /// <summary>
+    /// returns the number of strings each method has allocated in this process and the bytes they took, including
+    /// their length prefix and terminator
+    /// </summary>
+    /// <param name="methods">on success stores an array of the names of the methods that allocate strings</param>
+    /// <param name="allocations">on success stores an array of the allocations made by each method</param>
+    /// <param name="bytes">on success stores an array of the bytes allocated by each method</param>
+    /// <returns>
+    /// S_OK on success; otherwise E_INVALIDARG if any argument is nullptr, or E_OUTOFMEMORY if the arrays can't
+    /// be allocated
+    /// </returns>
+    STDMETHOD(GetStringStatistics)(SAFEARRAY** methods, SAFEARRAY** allocations, SAFEARRAY** bytes) noexcept override;
+
+    /// <summary>
+    /// returns Name, Id, Numeric and Description in one call, with the version of the state they were read from;
+    /// the version changes whenever Numeric does, so a client holding the current version can skip the refresh
+    /// </summary>
+    /// <param name="knownVersion">
+    /// version the client last read, 0 to always read the state; versions start at 1
+    /// </param>
+    /// <param name="state">
+    /// on success stores the current version and, if it differs from <paramref name="knownVersion"/>, every
+    /// property; otherwise the strings are null and Numeric is 0.  Numeric is at least as new as the version
+    /// </param>
+    /// <param name="changed">
+    /// on success stores VARIANT_TRUE if the properties were read, VARIANT_FALSE if the version was
+    /// <paramref name="knownVersion"/>
+    /// </param>
+    /// <returns>
+    /// S_OK on success; otherwise E_INVALIDARG if <paramref name="state"/> or <paramref name="changed"/> is
+    /// nullptr, or E_OUTOFMEMORY if the strings can't be allocated
+    /// </returns>
+    STDMETHOD(GetState)(LONGLONG knownVersion, SimpleObjectState* state, VARIANT_BOOL* changed) noexcept override;
+
+    /// <summary>
+    /// looks the member name up in a table built at compile time; parameter names are left to the type library
+    /// </summary>
+    STDMETHOD(GetIDsOfNames)(REFIID riid, LPOLESTR* names, UINT count, LCID lcid, DISPID* ids) override;
+
+    /// <summary>
+    /// calls the properties, and the methods taking only numbers and strings, directly with a switch on
+    /// <paramref name="id"/>, converting their arguments inline; other members, and calls with named arguments,
+    /// go through the type library.  A member which fails is reported as the type library reports it, as
+    /// DISP_E_EXCEPTION with the member's HRESULT in <paramref name="exception"/>
+    /// </summary>
+    STDMETHOD(Invoke)(DISPID id, REFIID riid, LCID lcid, WORD flags, DISPPARAMS* params, VARIANT* result,
+        EXCEPINFO* exception, UINT* argument_error) override;
+
     CSimpleObject() = default;
 
     DECLARE_REGISTRY_RESOURCEID(106)
@@ -107,6 +252,7 @@ public:
     BEGIN_COM_MAP(CSimpleObject)
     COM_INTERFACE_ENTRY(ISimpleObject)
     COM_INTERFACE_ENTRY(ISimpleObject2)
+    COM_INTERFACE_ENTRY(ISimpleObject3)
     COM_INTERFACE_ENTRY(IDispatch)
 
     // N.B. required for events (Connection point impl)
@@ -20,6 +20,16 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+
+#include "TSMoreland.Interop.Portable/coalescing_dispatcher.h"
+#include "TSMoreland.Interop.Portable/sink_snapshot.h"
+
 using namespace ATL;  // NOLINT(clang-diagnostic-header-hygiene)
 
 template <class T>
@@ -27,33 +37,182 @@ class CProxy_ISimpleObjectEvents  // NOLINT(clang-diagnostic-non-virtual-dtor)
     : public IConnectionPointImpl<T, &__uuidof(_ISimpleObjectEvents), CComDynamicUnkArray> {
 
     using base = IConnectionPointImpl<T, &__uuidof(_ISimpleObjectEvents), CComDynamicUnkArray>;
+
+    // mirrors base::m_vec so events can be fired without the object lock, updated under it by Advise and Unadvise
+    tsmoreland::interop::sink_snapshot<ATL::CComPtr<IDispatch>> sinks_;
+
+    // the dispatcher thread calls the sinks from the multithreaded apartment, which is only legal when the object
+    // lives there too; in a single threaded apartment the sinks are that apartment's own pointers, not proxies
+    struct multithreaded_apartment_scope {
+        HRESULT const result{::CoInitializeEx(nullptr, COINIT_MULTITHREADED)};
+
+        ~multithreaded_apartment_scope() {
+            if (SUCCEEDED(result)) {
+                ::CoUninitialize();
+            }
+        }
+    };
+
+    using event_dispatcher = tsmoreland::interop::coalescing_dispatcher<std::wstring, multithreaded_apartment_scope>;
+
+    // distinct property names waiting for delivery before further changes are dropped
+    static constexpr std::size_t async_event_capacity = 64;
+
+    // null unless async events are enabled, declared after sinks_ so it's stopped before they're released
+    std::atomic<std::shared_ptr<event_dispatcher>> dispatcher_;
+
 public:
+    STDMETHOD(Advise)(IUnknown* sink, DWORD* cookie) override {
+        T* p_this = static_cast<T*>(this);
+        typename T::ObjectLock const lock{p_this};
+
+        HRESULT const hr = base::Advise(sink, cookie);
+        if (FAILED(hr)) {
+            return hr;
+        }
+
+        // base::Advise queried the sink for the events dispinterface, the stored pointer is an IDispatch
+        try {
+            sinks_.add(*cookie, static_cast<IDispatch*>(base::m_vec.GetUnknown(*cookie)));
+        } catch (std::bad_alloc const&) {
+            base::Unadvise(*cookie);
+            *cookie = 0;
+            return E_OUTOFMEMORY;
+        }
+        return S_OK;
+    }
+
+    STDMETHOD(Unadvise)(DWORD cookie) override {
+        T* p_this = static_cast<T*>(this);
+        typename T::ObjectLock const lock{p_this};
+
+        // removed from the snapshot first, it's the only step that can fail
+        try {
+            sinks_.remove(cookie);
+        } catch (std::bad_alloc const&) {
+            return E_OUTOFMEMORY;
+        }
+        return base::Unadvise(cookie);
+    }
+
+    /// <summary>
+    /// calls OnPropertyChanaged on each connected sink
+    /// </summary>
+    /// <remarks>
+    /// takes no lock, the sinks are read from an immutable snapshot and every sink is passed the same parameters;
+    /// <paramref name="propertyName"/> is borrowed, not copied or freed
+    /// </remarks>
     HRESULT Fire_OnPropertyChanaged(BSTR propertyName) {
-        T* p_this      = static_cast<T*>(this);
-
-        for (int i = 0, size = base::m_vec.GetSize(); i < size; i++) {
-
-            p_this->Lock();
-            ATL::CComPtr<IUnknown> const unknown = base::m_vec.GetAt(i);
-            p_this->Unlock();
-
-            if (auto const dispatch = reinterpret_cast<IDispatch*>(unknown.p);
-                dispatch != nullptr) {
-
-                constexpr DISPID disp_id = 1; // see IDL file for id value
-                ATL::CComVariant parameters[1] = {ATL::CComVariant(propertyName)};
-                ATL::CComVariant result{};
-                DISPPARAMS params = {parameters, nullptr, 1, 0};
-                dispatch->Invoke(
-                    disp_id,
-                    IID_NULL,
-                    LOCALE_USER_DEFAULT,
-                    DISPATCH_METHOD,
-                    &params,
-                    &result,
-                    nullptr, nullptr);
+        auto const snapshot = sinks_.snapshot();
+        if (snapshot->empty()) {
+            return S_OK;
+        }
+
+        constexpr DISPID disp_id = 1; // see IDL file for id value
+        VARIANTARG parameter{};
+        parameter.vt      = VT_BSTR;
+        parameter.bstrVal = propertyName;
+        DISPPARAMS params = {&parameter, nullptr, 1, 0};
+
+        for (auto const& [cookie, dispatch] : *snapshot) {
+            ATL::CComVariant result{};
+            dispatch->Invoke(
+                disp_id,
+                IID_NULL,
+                LOCALE_USER_DEFAULT,
+                DISPATCH_METHOD,
+                &params,
+                &result,
+                nullptr, nullptr);
+        }
+        return S_OK;
+    }
+
+    /// <summary>
+    /// calls OnPropertyChanaged on each connected sink, as <see cref="Fire_OnPropertyChanaged"/> or, when async
+    /// events are enabled, later from the dispatcher thread coalesced with other changes to the same property
+    /// </summary>
+    /// <returns>S_OK on success; otherwise E_OUTOFMEMORY if the event can't be queued</returns>
+    HRESULT Post_OnPropertyChanaged(BSTR propertyName) {
+        if (sinks_.snapshot()->empty()) {
+            return S_OK;
+        }
+
+        auto const dispatcher = dispatcher_.load(std::memory_order_acquire);
+        if (dispatcher == nullptr) {
+            return Fire_OnPropertyChanaged(propertyName);
+        }
+        try {
+            dispatcher->post(std::wstring{propertyName, ::SysStringLen(propertyName)});
+        } catch (std::bad_alloc const&) {
+            return E_OUTOFMEMORY;
+        }
+        return S_OK;
+    }
+
+    /// <summary>
+    /// starts or stops the dispatcher thread used by <see cref="Post_OnPropertyChanaged"/>, stopping delivers the
+    /// events already queued first
+    /// </summary>
+    /// <remarks>
+    /// the object is registered as Both so it lives in its creator's apartment; async events can only be enabled
+    /// from the multithreaded apartment as the dispatcher thread can't call an STA client's sinks directly
+    /// </remarks>
+    /// <returns>
+    /// S_OK on success; otherwise E_ILLEGAL_METHOD_CALL if enabling from any apartment other than the multithreaded
+    /// apartment, E_OUTOFMEMORY if the dispatcher can't be allocated or E_FAIL if its thread can't be started
+    /// </returns>
+    HRESULT EnableAsyncEvents(bool const enabled) {
+        if (enabled) {
+            APTTYPE apartment{};
+            APTTYPEQUALIFIER qualifier{};
+            if (HRESULT const hr = ::CoGetApartmentType(&apartment, &qualifier); FAILED(hr)) {
+                return hr;
+            }
+            if (apartment != APTTYPE_MTA) {
+                return E_ILLEGAL_METHOD_CALL;
+            }
+        }
+
+        std::shared_ptr<event_dispatcher> previous;
+        {
+            T* p_this = static_cast<T*>(this);
+            typename T::ObjectLock const lock{p_this};
+
+            if (enabled == (dispatcher_.load(std::memory_order_acquire) != nullptr)) {
+                return S_OK;
+            }
+            if (!enabled) {
+                previous = dispatcher_.exchange(nullptr, std::memory_order_acq_rel);
+            } else {
+                try {
+                    dispatcher_.store(std::make_shared<event_dispatcher>(async_event_capacity,
+                        [this](std::wstring const& name) {
+                            Fire_OnPropertyChanaged(ATL::CComBSTR{static_cast<int>(name.size()), name.c_str()});
+                        }), std::memory_order_release);
+                } catch (std::bad_alloc const&) {
+                    return E_OUTOFMEMORY;
+                } catch (std::system_error const&) {
+                    return E_FAIL;
+                }
+                return S_OK;
             }
         }
+
+        // stopped outside the object lock, a sink being called may call back into the object
+        previous->stop();
         return S_OK;
     }
+
+    [[nodiscard]]
+    bool AsyncEventsEnabled() const noexcept {
+        return dispatcher_.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /// <returns>the counters of the current dispatcher, all 0 when async events are disabled</returns>
+    [[nodiscard]]
+    tsmoreland::interop::dispatcher_statistics AsyncEventStatistics() const {
+        auto const dispatcher = dispatcher_.load(std::memory_order_acquire);
+        return dispatcher != nullptr ? dispatcher->statistics() : tsmoreland::interop::dispatcher_statistics{};
+    }
 };
@@ -10,7 +10,11 @@
 // add headers that you want to pre-compile here
 #include "framework.h"
 
+#include <atlsafe.h>
+
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <memory>
 #include <ranges>
 #include <string>
@@ -12,85 +12,413 @@
 //
 
 #include "pch.h"
+
+#include <bit>
+#include <mutex>
+#include <span>
+#include <system_error>
+
 #include "SimpleOOPObject.h"
+#include "TSMoreland.Interop.Portable/case_conversion.h"
+#include "TSMoreland.Interop.Portable/dispatch_table.h"
+#include "TSMoreland.Interop.Portable/guid.h"
+#include "TSMoreland.Interop.Portable/ring_buffer.h"
+#include "TSMoreland.Interop.Portable/server_methods.h"
+#include "TSMoreland.Interop.Portable/shared_memory.h"
+#include "TSMoreland.Interop.Portable/string_allocator.h"
+
+using namespace tsmoreland::interop::literals;
+using tsmoreland::interop::convert_each;
+using tsmoreland::interop::copy_bstr;
+using tsmoreland::interop::upper_case_bstr;
+
+namespace {
+    /// <summary>
+    /// the methods that allocate strings, in the order GetStringStatistics reports them
+    /// </summary>
+    enum class string_method {
+        get_Name,
+        get_Description,
+        ToUpper,
+        ToUpperMany,
+        OnPropertyChanaged,
+        OpenChannel,
+        GetImmutableProperties,
+        GetState,
+        count,
+    };
+
+    constexpr std::array<std::wstring_view, static_cast<std::size_t>(string_method::count)> string_method_names{
+        L"get_Name",
+        L"get_Description",
+        L"ToUpper",
+        L"ToUpperMany",
+        L"OnPropertyChanaged",
+        L"OpenChannel",
+        L"GetImmutableProperties",
+        L"GetState",
+    };
+
+    using bstr_allocator = tsmoreland::interop::bstr_allocator<string_method>;
+
+    [[nodiscard]]
+    bstr_allocator& strings() noexcept {
+        static bstr_allocator allocator;
+        return allocator;
+    }
+
+    // the id is parsed at compile time, an invalid id fails the build
+    constexpr tsmoreland::interop::immutable_properties properties{
+        L"OOP Name",
+        tsmoreland::interop::to_win32("E3FF39CC-D456-4A43-A799-8B19A6139908"_guid),
+        L"OOP Description",
+    };
+
+    constexpr std::wstring_view numeric_property = L"Numeric";
+    constexpr std::wstring_view channel_prefix   = L"Local\\SimpleOOPObject-";
+
+    constexpr LONG max_channel_slot_count   = 4096;
+    constexpr LONG max_channel_slot_size    = 1 << 20;
+    constexpr std::size_t max_channel_bytes = 64 << 20;
+
+    /// <summary>
+    /// DISPID of each member, as declared in the IDL
+    /// </summary>
+    namespace dispid {
+        constexpr DISPID name                      = 1;
+        constexpr DISPID id                        = 2;
+        constexpr DISPID numeric                   = 3;
+        constexpr DISPID description               = 4;
+        constexpr DISPID to_upper                  = 5;
+        constexpr DISPID to_upper_many             = 6;
+        constexpr DISPID async_events              = 7;
+        constexpr DISPID get_event_statistics      = 8;
+        constexpr DISPID add_numeric               = 9;
+        constexpr DISPID compare_exchange_numeric  = 10;
+        constexpr DISPID get_string_statistics     = 11;
+        constexpr DISPID get_activation_statistics = 12;
+        constexpr DISPID open_channel              = 13;
+        constexpr DISPID process_channel           = 14;
+        constexpr DISPID get_immutable_properties  = 15;
+        constexpr DISPID get_state                 = 16;
+    } // namespace dispid
+
+    constexpr tsmoreland::interop::common_dispids common_members{
+        .name                     = dispid::name,
+        .numeric                  = dispid::numeric,
+        .description              = dispid::description,
+        .to_upper                 = dispid::to_upper,
+        .async_events             = dispid::async_events,
+        .add_numeric              = dispid::add_numeric,
+        .compare_exchange_numeric = dispid::compare_exchange_numeric,
+    };
 
-#include <memory>
+    constexpr tsmoreland::interop::perfect_hash_map dispatch_names{std::array<tsmoreland::interop::dispatch_name, 16>{{
+        {L"Name", dispid::name},
+        {L"Id", dispid::id},
+        {L"Numeric", dispid::numeric},
+        {L"Description", dispid::description},
+        {L"ToUpper", dispid::to_upper},
+        {L"ToUpperMany", dispid::to_upper_many},
+        {L"AsyncEvents", dispid::async_events},
+        {L"GetEventStatistics", dispid::get_event_statistics},
+        {L"AddNumeric", dispid::add_numeric},
+        {L"CompareExchangeNumeric", dispid::compare_exchange_numeric},
+        {L"GetStringStatistics", dispid::get_string_statistics},
+        {L"GetActivationStatistics", dispid::get_activation_statistics},
+        {L"OpenChannel", dispid::open_channel},
+        {L"ProcessChannel", dispid::process_channel},
+        {L"GetImmutableProperties", dispid::get_immutable_properties},
+        {L"GetState", dispid::get_state},
+    }}};
+} // namespace
 
 STDMETHODIMP CSimpleOOPObject::get_Name(BSTR* result) noexcept {
     if (result == nullptr) {
         return E_INVALIDARG;
     }
 
-    CComBSTR value{L"OOP Name"};
-    *result = value.Detach();
+    return copy_bstr(strings(), string_method::get_Name, properties.name, result);
+}
+STDMETHODIMP CSimpleOOPObject::get_Id(GUID* result) noexcept {
+    if (result == nullptr) {
+        return E_INVALIDARG;
+    }
 
+    *result = properties.id;
     return S_OK;
 }
-STDMETHODIMP CSimpleOOPObject::get_Id(GUID* result) noexcept {
+STDMETHODIMP CSimpleOOPObject::get_Numeric(LONG* result) noexcept {
     if (result == nullptr) {
         return E_INVALIDARG;
     }
 
-    constexpr auto source = "E3FF39CC-D456-4A43-A799-8B19A6139908";
-    auto const uuid       = std::make_unique<char[]>(64);
-    strcpy_s(uuid.get(), 64, source);
+    *result = numeric_.load(std::memory_order_acquire);
 
-    if (GUID id{};
-        RPC_S_OK == UuidFromStringA(reinterpret_cast<RPC_CSTR>(uuid.get()), &id)) {
-        *result = id;
-        return S_OK;
+    return S_OK;
+}
+STDMETHODIMP CSimpleOOPObject::put_Numeric(LONG value) noexcept {
+
+    numeric_.store(value, std::memory_order_release);
+    version_.fetch_add(1, std::memory_order_release);
+    Post_OnPropertyChanaged(strings().intern(string_method::OnPropertyChanaged, numeric_property));
+    return S_OK;
+}
+STDMETHODIMP CSimpleOOPObject::get_Description(BSTR *result) noexcept  {
+    if (result == nullptr) {
+        return E_INVALIDARG;
     }
 
-    *result = GUID{};
+    return copy_bstr(strings(), string_method::get_Description, properties.description, result);
+}
 
-    return E_FAIL;
+STDMETHODIMP CSimpleOOPObject::ToUpper(BSTR input, BSTR* result) noexcept {
+    if (input == nullptr || result == nullptr) {
+        return E_INVALIDARG;
+    }
 
-    return S_OK;
+    return upper_case_bstr(strings(), string_method::ToUpper, input, result);
 }
-STDMETHODIMP CSimpleOOPObject::get_Numeric(LONG* result) noexcept {
+
+STDMETHODIMP CSimpleOOPObject::ToUpperMany(SAFEARRAY* inputs, SAFEARRAY** results) noexcept {
+    return convert_each<BSTR>(inputs, VT_BSTR, results, [](BSTR const input, BSTR* result) noexcept {
+        return upper_case_bstr(strings(), string_method::ToUpperMany, input, result);
+    });
+}
+
+STDMETHODIMP CSimpleOOPObject::get_AsyncEvents(VARIANT_BOOL* result) noexcept {
     if (result == nullptr) {
         return E_INVALIDARG;
     }
 
-    *result = numeric_;
+    *result = AsyncEventsEnabled() ? VARIANT_TRUE : VARIANT_FALSE;
+    return S_OK;
+}
+
+STDMETHODIMP CSimpleOOPObject::put_AsyncEvents(VARIANT_BOOL value) noexcept {
+    return EnableAsyncEvents(value != VARIANT_FALSE);
+}
+
+STDMETHODIMP CSimpleOOPObject::GetEventStatistics(LONG* queueDepth, LONGLONG* coalesced, LONGLONG* dropped) noexcept {
+    if (queueDepth == nullptr || coalesced == nullptr || dropped == nullptr) {
+        return E_INVALIDARG;
+    }
 
+    try {
+        auto const statistics = AsyncEventStatistics();
+        *queueDepth           = static_cast<LONG>(statistics.queue_depth);
+        *coalesced            = static_cast<LONGLONG>(statistics.coalesced);
+        *dropped              = static_cast<LONGLONG>(statistics.dropped);
+    } catch (std::system_error const&) {
+        return E_FAIL;
+    }
     return S_OK;
 }
-STDMETHODIMP CSimpleOOPObject::put_Numeric(LONG value) noexcept {
 
-    numeric_ = value;
-    Fire_OnPropertyChanaged(CComBSTR{L"Numeric"}.Detach());
+STDMETHODIMP CSimpleOOPObject::AddNumeric(LONG delta, LONG* result) noexcept {
+    if (result == nullptr) {
+        return E_INVALIDARG;
+    }
+
+    // fetch_add on a signed atomic wraps rather than overflowing, the new value is computed unsigned to match
+    LONG const previous = numeric_.fetch_add(delta, std::memory_order_acq_rel);
+    *result             = static_cast<LONG>(static_cast<ULONG>(previous) + static_cast<ULONG>(delta));
+    if (delta != 0) {
+        version_.fetch_add(1, std::memory_order_release);
+        Post_OnPropertyChanaged(strings().intern(string_method::OnPropertyChanaged, numeric_property));
+    }
     return S_OK;
 }
-STDMETHODIMP CSimpleOOPObject::get_Description(BSTR *result) noexcept  {
+
+STDMETHODIMP CSimpleOOPObject::CompareExchangeNumeric(LONG value, LONG comparand, LONG* result) noexcept {
     if (result == nullptr) {
         return E_INVALIDARG;
     }
 
-    CComBSTR value{L"OOP Description"};
-    *result = value.Detach();
+    LONG original = comparand;
+    if (numeric_.compare_exchange_strong(original, value, std::memory_order_acq_rel, std::memory_order_acquire) &&
+        value != comparand) {
+        version_.fetch_add(1, std::memory_order_release);
+        Post_OnPropertyChanaged(strings().intern(string_method::OnPropertyChanaged, numeric_property));
+    }
+    *result = original;
+    return S_OK;
+}
 
+STDMETHODIMP CSimpleOOPObject::GetStringStatistics(
+    SAFEARRAY** methods, SAFEARRAY** allocations, SAFEARRAY** bytes) noexcept {
+    return tsmoreland::interop::string_statistics(strings(), string_method_names, methods, allocations, bytes);
+}
+
+STDMETHODIMP CSimpleOOPObject::GetActivationStatistics(LONGLONG* activations, LONGLONG* poolHits, LONG* idle,
+    double* meanMicroseconds, double* p99Microseconds, double* maxMicroseconds) noexcept {
+    if (activations == nullptr || poolHits == nullptr || idle == nullptr || meanMicroseconds == nullptr ||
+        p99Microseconds == nullptr || maxMicroseconds == nullptr) {
+        return E_INVALIDARG;
+    }
+
+    auto const pool    = CSimpleOOPObjectPool::PoolStatistics();
+    auto const latency = CSimpleOOPObjectPool::ActivationLatency();
+    *activations       = static_cast<LONGLONG>(latency.count);
+    *poolHits          = static_cast<LONGLONG>(pool.hits);
+    *idle              = static_cast<LONG>(pool.idle);
+    *meanMicroseconds  = latency.mean_ns / 1000.0;
+    *p99Microseconds   = static_cast<double>(latency.p99_ns) / 1000.0;
+    *maxMicroseconds   = static_cast<double>(latency.max_ns) / 1000.0;
     return S_OK;
 }
 
-STDMETHODIMP CSimpleOOPObject::ToUpper(BSTR input, BSTR* result) noexcept {
-    if (input == nullptr || result == nullptr) {
+void CSimpleOOPObject::Reset() noexcept {
+    numeric_.store(0, std::memory_order_release);
+    version_.fetch_add(1, std::memory_order_release);
+    channel_.store(nullptr, std::memory_order_release);
+    ResetConnections();
+}
+
+struct CSimpleOOPObject::bulk_channel {
+    tsmoreland::interop::shared_memory memory;
+    tsmoreland::interop::ring_channel rings;
+    // one ProcessChannel at a time, so responses are written in the order the requests were read
+    std::mutex lock;
+};
+
+STDMETHODIMP CSimpleOOPObject::OpenChannel(LONG slotCount, LONG slotSize, BSTR* name) noexcept {
+    if (name == nullptr || slotCount < 2 || slotCount > max_channel_slot_count ||
+        !std::has_single_bit(static_cast<ULONG>(slotCount)) || slotSize < 2 || slotSize > max_channel_slot_size ||
+        slotSize % sizeof(wchar_t) != 0) {
+        return E_INVALIDARG;
+    }
+    auto const slot_count  = static_cast<std::uint32_t>(slotCount);
+    auto const slot_size   = static_cast<std::uint32_t>(slotSize);
+    std::size_t const size = tsmoreland::interop::ring_channel::required_size(slot_count, slot_size);
+    if (size > max_channel_bytes) {
+        return E_INVALIDARG;
+    }
+
+    // a new name each time, so a process can't create the block first and watch the channel
+    GUID id{};
+    if (HRESULT const hr = ::CoCreateGuid(&id); FAILED(hr)) {
+        return hr;
+    }
+
+    try {
+        using tsmoreland::interop::guid_string_length;
+        std::wstring region{channel_prefix};
+        region.resize(channel_prefix.size() + guid_string_length);
+        tsmoreland::interop::format_guid(tsmoreland::interop::from_win32(id),
+            std::span<wchar_t, guid_string_length>{region.data() + channel_prefix.size(), guid_string_length});
+
+        auto memory  = tsmoreland::interop::shared_memory::create(region, size);
+        auto rings   = tsmoreland::interop::ring_channel::create(memory.bytes(), slot_count, slot_size);
+        auto channel = std::make_shared<bulk_channel>(std::move(memory), rings);
+
+        if (HRESULT const hr = copy_bstr(strings(), string_method::OpenChannel, region, name); FAILED(hr)) {
+            return hr;
+        }
+        channel_.store(std::move(channel), std::memory_order_release);
+    } catch (std::bad_alloc const&) {
+        return E_OUTOFMEMORY;
+    } catch (std::system_error const& error) {
+        return HRESULT_FROM_WIN32(static_cast<DWORD>(error.code().value()));
+    }
+    return S_OK;
+}
+
+STDMETHODIMP CSimpleOOPObject::ProcessChannel(LONG* processed) noexcept {
+    if (processed == nullptr) {
+        return E_INVALIDARG;
+    }
+    auto const channel = channel_.load(std::memory_order_acquire);
+    if (channel == nullptr) {
+        return E_ILLEGAL_METHOD_CALL;
+    }
+
+    std::scoped_lock const guard{channel->lock};
+    auto& requests  = channel->rings.requests;
+    auto& responses = channel->rings.responses;
+
+    // the converted string is written straight into its response slot; a slot is known to be free before the
+    // request is taken and both rings have the same slot size, so the write can't fail
+    auto const convert = [&responses](std::span<std::byte const> const request) noexcept {
+        std::size_t const length = request.size() / sizeof(wchar_t);
+        responses.try_write(length * sizeof(wchar_t), [request, length](std::span<std::byte> const response) noexcept {
+            tsmoreland::interop::to_upper(std::wstring_view{reinterpret_cast<wchar_t const*>(request.data()), length},
+                std::span{reinterpret_cast<wchar_t*>(response.data()), length});
+        });
+    };
+
+    LONG count = 0;
+    while (!responses.full() && requests.try_read(convert)) {
+        count++;
+    }
+    *processed = count;
+    return S_OK;
+}
+
+STDMETHODIMP CSimpleOOPObject::GetImmutableProperties(BSTR* name, GUID* id, BSTR* description) noexcept {
+    if (name == nullptr || id == nullptr || description == nullptr) {
         return E_INVALIDARG;
     }
 
-    std::wstring upper{input};
-    std::ranges::for_each(upper, [](wchar_t& ch) { ch = ::towupper(ch); });
+    constexpr auto method = string_method::GetImmutableProperties;
+    ATL::CComBSTR name_copy;
+    if (HRESULT const hr = copy_bstr(strings(), method, properties.name, &name_copy); FAILED(hr)) {
+        return hr;
+    }
+    if (HRESULT const hr = copy_bstr(strings(), method, properties.description, description); FAILED(hr)) {
+        return hr;
+    }
 
-    CComBSTR output{upper.c_str()};
-    *result = output.Detach();
+    *name = name_copy.Detach();
+    *id   = properties.id;
     return S_OK;
 }
 
+STDMETHODIMP CSimpleOOPObject::GetState(LONGLONG knownVersion, SimpleOOPObjectState* state, VARIANT_BOOL* changed) noexcept {
+    return tsmoreland::interop::read_state(
+        strings(), string_method::GetState, properties, version_, numeric_, knownVersion, state, changed);
+}
+
+STDMETHODIMP CSimpleOOPObject::GetIDsOfNames(REFIID riid, LPOLESTR* names, UINT count, LCID lcid, DISPID* ids) {
+    if (!::InlineIsEqualGUID(riid, IID_NULL)) {
+        return DISP_E_UNKNOWNINTERFACE;
+    }
+    if (count != 1 || names == nullptr || names[0] == nullptr || ids == nullptr) {
+        return dispatch_base::GetIDsOfNames(riid, names, count, lcid, ids);
+    }
+
+    // the table holds every member, a name it doesn't have isn't one
+    auto const id = dispatch_names.find(names[0]);
+    ids[0]        = id.value_or(DISPID_UNKNOWN);
+    return id.has_value() ? S_OK : DISP_E_UNKNOWNNAME;
+}
+
+STDMETHODIMP CSimpleOOPObject::Invoke(DISPID id, REFIID riid, LCID lcid, WORD flags, DISPPARAMS* params,
+    VARIANT* result, EXCEPINFO* exception, UINT* argument_error) {
+    if (!::InlineIsEqualGUID(riid, IID_NULL)) {
+        return DISP_E_UNKNOWNINTERFACE;
+    }
+    if (params != nullptr) {
+        tsmoreland::interop::dispatch_call const call{flags, *params};
+        if (auto const hr = tsmoreland::interop::invoke_common_member<common_members>(
+                *this, id, call, result, exception, argument_error);
+            hr.has_value()) {
+            return *hr;
+        }
+        if (id == dispid::process_channel && call.method && call.count == 0) {
+            return tsmoreland::interop::dispatch_get(*this, &CSimpleOOPObject::ProcessChannel, result, exception);
+        }
+    }
+    return dispatch_base::Invoke(id, riid, lcid, flags, params, result, exception, argument_error);
+}
+
 #pragma region infrastructure
 HRESULT CSimpleOOPObject::FinalConstruct() {
     return S_OK;
 }
 
 void CSimpleOOPObject::FinalRelease() {
+    // delivers any queued events while the object is still whole
+    EnableAsyncEvents(false);
 }
 #pragma endregion
@@ -18,6 +18,7 @@
 
 #include "SimpleOutOfProcessCOM_i.h"
 #include "_ISimpleOOPObjectEvents_CP.h"
+#include "SimpleOOPObjectPool.h"
 
 
 
@@ -34,9 +35,18 @@ class ATL_NO_VTABLE CSimpleOOPObject : public CComObjectRootEx<CComMultiThreadMo
                                        public CComCoClass<CSimpleOOPObject, &CLSID_SimpleOOPObject>,
                                        public IConnectionPointContainerImpl<CSimpleOOPObject>,
                                        public CProxy_ISimpleOOPObjectEvents<CSimpleOOPObject>,
-                                       public IDispatchImpl<ISimpleOOPObject2, &IID_ISimpleOOPObject2,
+                                       public IDispatchImpl<ISimpleOOPObject3, &IID_ISimpleOOPObject3,
                                            &LIBID_SimpleOutOfProcessCOMLib, /*wMajor =*/1, /*wMinor =*/0> {
-    LONG numeric_{0};
+    std::atomic<LONG> numeric_{0};
+    // incremented after every change to numeric_, see GetState
+    std::atomic<LONGLONG> version_{1};
+
+    using dispatch_base = IDispatchImpl<ISimpleOOPObject3, &IID_ISimpleOOPObject3, &LIBID_SimpleOutOfProcessCOMLib,
+        /*wMajor =*/1, /*wMinor =*/0>;
+
+    // the shared memory channel, null until OpenChannel is called
+    struct bulk_channel;
+    std::atomic<std::shared_ptr<bulk_channel>> channel_;
 
 public:
     STDMETHOD(get_Name)(BSTR* result) noexcept override;
@@ -50,9 +60,191 @@ public:
     /// </summary>
     /// <param name="input">source to convert</param>
     /// <param name="result">stores the upper case result</param>
-    /// <returns>S_OK on success; otherwise E_INVALIDARG if input is a nullptr</returns>
+    /// <returns>
+    /// S_OK on success; otherwise E_INVALIDARG if input is a nullptr or E_OUTOFMEMORY if the result can't be allocated
+    /// </returns>
     STDMETHOD(ToUpper)(BSTR input, BSTR* result) noexcept override;
 
+    /// <summary>
+    /// Convert each string of <paramref name="inputs"/> to upper case, as <see cref="ToUpper"/>, in a single call
+    /// </summary>
+    /// <param name="inputs">one dimensional array of strings to convert, null elements are treated as empty</param>
+    /// <param name="results">
+    /// on success stores a new array with the same bounds holding the upper case form of each input
+    /// </param>
+    /// <returns>
+    /// S_OK on success; otherwise E_INVALIDARG if either argument is a nullptr or <paramref name="inputs"/> isn't
+    /// a one dimensional array of BSTR, or E_OUTOFMEMORY if the results can't be allocated
+    /// </returns>
+    STDMETHOD(ToUpperMany)(SAFEARRAY* inputs, SAFEARRAY** results) noexcept override;
+
+    /// <summary>
+    /// returns whether property change events are delivered asynchronously
+    /// </summary>
+    /// <param name="result">on success stores VARIANT_TRUE if events are asynchronous, otherwise VARIANT_FALSE</param>
+    /// <returns>
+    /// S_OK on success, otherwise E_INVALIDARG if <paramref name="result"/> is nullptr
+    /// </returns>
+    STDMETHOD(get_AsyncEvents)(VARIANT_BOOL* result) noexcept override;
+
+    /// <summary>
+    /// switches property change events between delivery on the writing thread and delivery from a dispatcher
+    /// thread, which coalesces repeated changes to a property not yet delivered and drops changes once too many
+    /// properties are waiting
+    /// </summary>
+    /// <param name="value">
+    /// VARIANT_TRUE to deliver asynchronously, VARIANT_FALSE to deliver the queued events and return to synchronous
+    /// delivery
+    /// </param>
+    /// <returns>
+    /// S_OK on success; otherwise E_OUTOFMEMORY if the dispatcher can't be allocated or E_FAIL if its thread can't
+    /// be started
+    /// </returns>
+    STDMETHOD(put_AsyncEvents)(VARIANT_BOOL value) noexcept override;
+
+    /// <summary>
+    /// returns the counters of asynchronous event delivery since it was last enabled, all 0 while it's disabled
+    /// </summary>
+    /// <param name="queueDepth">on success stores the number of properties waiting for delivery</param>
+    /// <param name="coalesced">on success stores the number of changes merged with one already waiting</param>
+    /// <param name="dropped">on success stores the number of changes dropped because the queue was full</param>
+    /// <returns>
+    /// S_OK on success, otherwise E_INVALIDARG if any argument is nullptr
+    /// </returns>
+    STDMETHOD(GetEventStatistics)(LONG* queueDepth, LONGLONG* coalesced, LONGLONG* dropped) noexcept override;
+
+    /// <summary>
+    /// adds <paramref name="delta"/> to the numeric value in one atomic step, wrapping on overflow
+    /// </summary>
+    /// <param name="delta">amount to add, may be negative</param>
+    /// <param name="result">on success stores the numeric value after the addition</param>
+    /// <returns>
+    /// S_OK on success, otherwise E_INVALIDARG if <paramref name="result"/> is nullptr
+    /// </returns>
+    STDMETHOD(AddNumeric)(LONG delta, LONG* result) noexcept override;
+
+    /// <summary>
+    /// sets the numeric value to <paramref name="value"/> if it currently equals <paramref name="comparand"/>, in
+    /// one atomic step as InterlockedCompareExchange
+    /// </summary>
+    /// <param name="value">value to store</param>
+    /// <param name="comparand">value the numeric value must hold for <paramref name="value"/> to be stored</param>
+    /// <param name="result">
+    /// on success stores the numeric value before the call, equal to <paramref name="comparand"/> if it was replaced
+    /// </param>
+    /// <returns>
+    /// S_OK on success, otherwise E_INVALIDARG if <paramref name="result"/> is nullptr
+    /// </returns>
+    STDMETHOD(CompareExchangeNumeric)(LONG value, LONG comparand, LONG* result) noexcept override;
+
+    /// <summary>
+    /// returns the number of strings each method has allocated in this process and the bytes they took, including
+    /// their length prefix and terminator
+    /// </summary>
+    /// <param name="methods">on success stores an array of the names of the methods that allocate strings</param>
+    /// <param name="allocations">on success stores an array of the allocations made by each method</param>
+    /// <param name="bytes">on success stores an array of the bytes allocated by each method</param>
+    /// <returns>
+    /// S_OK on success; otherwise E_INVALIDARG if any argument is nullptr, or E_OUTOFMEMORY if the arrays can't
+    /// be allocated
+    /// </returns>
+    STDMETHOD(GetStringStatistics)(SAFEARRAY** methods, SAFEARRAY** allocations, SAFEARRAY** bytes) noexcept override;
+
+    /// <summary>
+    /// returns how many objects this server has activated, how many came from the pool and how long activation took
+    /// </summary>
+    /// <param name="activations">on success stores the number of objects activated</param>
+    /// <param name="poolHits">on success stores the number of activations given an idle pooled object</param>
+    /// <param name="idle">on success stores the number of pooled objects waiting to be activated</param>
+    /// <param name="meanMicroseconds">on success stores the mean activation time</param>
+    /// <param name="p99Microseconds">
+    /// on success stores the time 99% of activations completed within, to the power of 2 nanoseconds above it
+    /// </param>
+    /// <param name="maxMicroseconds">on success stores the longest activation time</param>
+    /// <returns>
+    /// S_OK on success, otherwise E_INVALIDARG if any argument is nullptr
+    /// </returns>
+    STDMETHOD(GetActivationStatistics)(LONGLONG* activations, LONGLONG* poolHits, LONG* idle,
+        double* meanMicroseconds, double* p99Microseconds, double* maxMicroseconds) noexcept override;
+
+    /// <summary>
+    /// creates a block of shared memory holding two rings of <paramref name="slotCount"/> messages of up to
+    /// <paramref name="slotSize"/> bytes, replacing any channel opened before.  The client maps the block by name,
+    /// writes UTF-16 strings to the request ring and calls <see cref="ProcessChannel"/>; the upper case form of each
+    /// is written to the response ring in the same order
+    /// </summary>
+    /// <param name="slotCount">messages each ring holds, a power of 2 from 2 to 4096</param>
+    /// <param name="slotSize">largest message in bytes, an even number from 2 to 1048576</param>
+    /// <param name="name">on success stores the name of the block, see ring_channel for its layout</param>
+    /// <returns>
+    /// S_OK on success; otherwise E_INVALIDARG if an argument is out of range or the channel would be larger than
+    /// 64MB, E_OUTOFMEMORY if the name can't be allocated, or the error creating the block
+    /// </returns>
+    STDMETHOD(OpenChannel)(LONG slotCount, LONG slotSize, BSTR* name) noexcept override;
+
+    /// <summary>
+    /// converts the strings waiting in the request ring until it's empty or the response ring is full
+    /// </summary>
+    /// <param name="processed">on success stores the number of strings converted</param>
+    /// <returns>
+    /// S_OK on success; otherwise E_INVALIDARG if <paramref name="processed"/> is nullptr or E_ILLEGAL_METHOD_CALL
+    /// if no channel is open
+    /// </returns>
+    STDMETHOD(ProcessChannel)(LONG* processed) noexcept override;
+
+    /// <summary>
+    /// returns Name, Id and Description in one round trip; none of them change once the object is created, so a
+    /// client can keep the values rather than asking for each again
+    /// </summary>
+    /// <param name="name">on success stores the value of Name</param>
+    /// <param name="id">on success stores the value of Id</param>
+    /// <param name="description">on success stores the value of Description</param>
+    /// <returns>
+    /// S_OK on success; otherwise E_INVALIDARG if any argument is nullptr or E_OUTOFMEMORY if the strings can't
+    /// be allocated
+    /// </returns>
+    STDMETHOD(GetImmutableProperties)(BSTR* name, GUID* id, BSTR* description) noexcept override;
+
+    /// <summary>
+    /// returns Name, Id, Numeric and Description in one call, with the version of the state they were read from;
+    /// the version changes whenever Numeric does, so a client holding the current version can skip the refresh
+    /// </summary>
+    /// <param name="knownVersion">
+    /// version the client last read, 0 to always read the state; versions start at 1
+    /// </param>
+    /// <param name="state">
+    /// on success stores the current version and, if it differs from <paramref name="knownVersion"/>, every
+    /// property; otherwise the strings are null and Numeric is 0.  Numeric is at least as new as the version
+    /// </param>
+    /// <param name="changed">
+    /// on success stores VARIANT_TRUE if the properties were read, VARIANT_FALSE if the version was
+    /// <paramref name="knownVersion"/>
+    /// </param>
+    /// <returns>
+    /// S_OK on success; otherwise E_INVALIDARG if <paramref name="state"/> or <paramref name="changed"/> is
+    /// nullptr, or E_OUTOFMEMORY if the strings can't be allocated
+    /// </returns>
+    STDMETHOD(GetState)(LONGLONG knownVersion, SimpleOOPObjectState* state, VARIANT_BOOL* changed) noexcept override;
+
+    /// <summary>
+    /// looks the member name up in a table built at compile time; parameter names are left to the type library
+    /// </summary>
+    STDMETHOD(GetIDsOfNames)(REFIID riid, LPOLESTR* names, UINT count, LCID lcid, DISPID* ids) override;
+
+    /// <summary>
+    /// calls the properties, and the methods taking only numbers and strings, directly with a switch on
+    /// <paramref name="id"/>, converting their arguments inline; other members, and calls with named arguments,
+    /// go through the type library.  A member which fails is reported as the type library reports it, as
+    /// DISP_E_EXCEPTION with the member's HRESULT in <paramref name="exception"/>
+    /// </summary>
+    STDMETHOD(Invoke)(DISPID id, REFIID riid, LCID lcid, WORD flags, DISPPARAMS* params, VARIANT* result,
+        EXCEPINFO* exception, UINT* argument_error) override;
+
+    /// <summary>
+    /// returns the object to the state it was created in, called by the pool before the object is reused
+    /// </summary>
+    void Reset() noexcept;
+
 #pragma region infrastructure
 
     CSimpleOOPObject() = default;
@@ -61,9 +253,13 @@ public:
 
     DECLARE_NOT_AGGREGATABLE(CSimpleOOPObject)
 
+    // pooling is configured by the server command line, see CSimpleOOPObjectPool
+    DECLARE_CLASSFACTORY_EX(CSimpleOOPObjectFactory)
+
     BEGIN_COM_MAP(CSimpleOOPObject)
     COM_INTERFACE_ENTRY(ISimpleOOPObject)
     COM_INTERFACE_ENTRY(ISimpleOOPObject2)
+    COM_INTERFACE_ENTRY(ISimpleOOPObject3)
     COM_INTERFACE_ENTRY(IDispatch)
 
     // N.B. required for events (Connection point impl)
@@ -0,0 +1,280 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+#include "pch.h"
+#include "SimpleOOPObject.h"
+#include "SimpleOOPObjectPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cwchar>
+#include <new>
+#include <string_view>
+
+namespace {
+    /// <summary>
+    /// SimpleOOPObject as activated by the pool, in place of CComObject; when the last reference is released the
+    /// object is handed back to the pool rather than deleted
+    /// </summary>
+    class CPooledSimpleOOPObject final : public CSimpleOOPObject {
+    public:
+        CPooledSimpleOOPObject() = default;
+        CPooledSimpleOOPObject(CPooledSimpleOOPObject const&)            = delete;
+        CPooledSimpleOOPObject& operator=(CPooledSimpleOOPObject const&) = delete;
+
+        ~CPooledSimpleOOPObject() {
+            // as CComObject, guards against FinalRelease adding and releasing a reference
+            m_dwRef = -(LONG_MAX / 2);
+            FinalRelease();
+        }
+
+        STDMETHOD_(ULONG, AddRef)() override {
+            return InternalAddRef();
+        }
+
+        STDMETHOD_(ULONG, Release)() override;
+
+        STDMETHOD(QueryInterface)(REFIID iid, void** object) override {
+            return _InternalQueryInterface(iid, object);
+        }
+    };
+
+    using pool_type = tsmoreland::interop::object_pool<CPooledSimpleOOPObject>;
+
+    [[nodiscard]]
+    pool_type& pool() noexcept {
+        static pool_type instances;
+        return instances;
+    }
+
+    // set by Configure, read by every activation
+    std::atomic<bool> pooling_enabled{false};
+
+    [[nodiscard]]
+    tsmoreland::interop::latency_histogram& activation_latency() noexcept {
+        static tsmoreland::interop::latency_histogram latency;
+        return latency;
+    }
+
+    /// <summary>
+    /// constructs an object as CComCreator does, leaving its reference count at 0
+    /// </summary>
+    HRESULT create(CPooledSimpleOOPObject** result) noexcept {
+        auto* const object = new (std::nothrow) CPooledSimpleOOPObject;
+        if (object == nullptr) {
+            return E_OUTOFMEMORY;
+        }
+
+        object->SetVoid(nullptr);
+        object->InternalFinalConstructAddRef();
+        HRESULT hr = object->_AtlInitialConstruct();
+        if (SUCCEEDED(hr)) {
+            hr = object->FinalConstruct();
+        }
+        if (SUCCEEDED(hr)) {
+            hr = object->_AtlFinalConstruct();
+        }
+        object->InternalFinalConstructRelease();
+        if (FAILED(hr)) {
+            delete object;
+            return hr;
+        }
+
+        *result = object;
+        return S_OK;
+    }
+
+    /// <summary>
+    /// resets <paramref name="object"/> and keeps it for the next activation, or destroys it if the pool is full,
+    /// then releases the module lock taken when it was activated
+    /// </summary>
+    void recycle(CPooledSimpleOOPObject* const object) noexcept {
+        // held while resetting so a sink released by the reset can't recycle the object a second time
+        object->InternalAddRef();
+        object->Reset();
+        object->InternalRelease();
+
+        if (!pool().try_return(object)) {
+            delete object;
+        }
+        _pAtlModule->Unlock();
+    }
+
+    /// <summary>
+    /// parses the unsigned decimal value of <paramref name="text"/>, rejecting anything else
+    /// </summary>
+    bool try_parse_size(std::wstring_view const text, std::size_t& value) noexcept {
+        if (text.empty()) {
+            return false;
+        }
+
+        std::size_t parsed{};
+        for (wchar_t const digit : text) {
+            if (digit < L'0' || digit > L'9' || parsed > (SIZE_MAX - 9) / 10) {
+                return false;
+            }
+            parsed = parsed * 10 + static_cast<std::size_t>(digit - L'0');
+        }
+        value = parsed;
+        return true;
+    }
+
+    /// <summary>
+    /// true if <paramref name="argument"/> is <paramref name="name"/>, ignoring case
+    /// </summary>
+    bool is_option(std::wstring_view const argument, std::wstring_view const name) noexcept {
+        return argument.size() == name.size() && ::_wcsnicmp(argument.data(), name.data(), name.size()) == 0;
+    }
+} // namespace
+
+STDMETHODIMP_(ULONG) CPooledSimpleOOPObject::Release() {
+    ULONG const count = InternalRelease();
+    if (count == 0) {
+        recycle(this);
+    }
+    return count;
+}
+
+STDMETHODIMP CSimpleOOPObjectFactory::CreateInstance(LPUNKNOWN outer, REFIID riid, void** object) {
+    if (!CSimpleOOPObjectPool::Enabled()) {
+        // still timed so activation statistics can be compared with and without the pool
+        auto const start = std::chrono::steady_clock::now();
+        HRESULT const hr = CComClassFactory::CreateInstance(outer, riid, object);
+        CSimpleOOPObjectPool::RecordActivation(std::chrono::steady_clock::now() - start);
+        return hr;
+    }
+
+    if (object == nullptr) {
+        return E_POINTER;
+    }
+    *object = nullptr;
+    if (outer != nullptr) {
+        return CLASS_E_NOAGGREGATION;
+    }
+
+    return CSimpleOOPObjectPool::Activate(riid, object);
+}
+
+CSimpleOOPObjectPool::options CSimpleOOPObjectPool::ParseCommandLine(LPCWSTR const command_line) noexcept {
+    options settings{};
+    if (command_line == nullptr) {
+        return settings;
+    }
+
+    std::wstring_view remaining{command_line};
+    while (!remaining.empty()) {
+        std::size_t const start = remaining.find_first_not_of(L" \t");
+        if (start == std::wstring_view::npos) {
+            break;
+        }
+        remaining.remove_prefix(start);
+        std::size_t const end      = std::min(remaining.find_first_of(L" \t"), remaining.size());
+        std::wstring_view argument = remaining.substr(0, end);
+        remaining.remove_prefix(end);
+
+        if (argument.front() != L'-' && argument.front() != L'/') {
+            continue;
+        }
+        argument.remove_prefix(1);
+        std::size_t const separator = argument.find(L'=');
+        if (separator == std::wstring_view::npos) {
+            continue;
+        }
+
+        std::wstring_view const name  = argument.substr(0, separator);
+        std::wstring_view const value = argument.substr(separator + 1);
+        if (is_option(name, L"PoolSize")) {
+            try_parse_size(value, settings.size);
+        } else if (is_option(name, L"WarmUp")) {
+            try_parse_size(value, settings.warm_up);
+        }
+    }
+    return settings;
+}
+
+HRESULT CSimpleOOPObjectPool::Configure(options const& settings) noexcept {
+    if (settings.size == 0) {
+        Drain();
+        return S_OK;
+    }
+
+    try {
+        for (CPooledSimpleOOPObject* const excess : pool().set_capacity(settings.size)) {
+            delete excess;
+        }
+    } catch (std::bad_alloc const&) {
+        return E_OUTOFMEMORY;
+    }
+    pooling_enabled.store(true, std::memory_order_release);
+
+    for (std::size_t i = 0; i < std::min(settings.warm_up, settings.size); i++) {
+        CPooledSimpleOOPObject* object{};
+        if (HRESULT const hr = create(&object); FAILED(hr)) {
+            return hr;
+        }
+        if (!pool().try_return(object)) {
+            delete object;
+            break;
+        }
+    }
+    return S_OK;
+}
+
+HRESULT CSimpleOOPObjectPool::Activate(REFIID riid, void** object) noexcept {
+    auto const start = std::chrono::steady_clock::now();
+
+    CPooledSimpleOOPObject* instance = pool().try_acquire();
+    if (instance == nullptr) {
+        if (HRESULT const hr = create(&instance); FAILED(hr)) {
+            return hr;
+        }
+    }
+
+    // held until the object is recycled, as CComObject holds it for its lifetime
+    _pAtlModule->Lock();
+    instance->InternalAddRef();
+    HRESULT const hr = instance->QueryInterface(riid, object);
+    // recycles the object if the query failed
+    instance->Release();
+
+    activation_latency().record(std::chrono::steady_clock::now() - start);
+    return hr;
+}
+
+void CSimpleOOPObjectPool::Drain() noexcept {
+    // instances still active when pooling stops are destroyed on release, as the emptied pool has no room for them
+    pooling_enabled.store(false, std::memory_order_release);
+    for (CPooledSimpleOOPObject* const idle : pool().drain()) {
+        delete idle;
+    }
+}
+
+bool CSimpleOOPObjectPool::Enabled() noexcept {
+    return pooling_enabled.load(std::memory_order_acquire);
+}
+
+void CSimpleOOPObjectPool::RecordActivation(std::chrono::nanoseconds const elapsed) noexcept {
+    activation_latency().record(elapsed);
+}
+
+tsmoreland::interop::object_pool_statistics CSimpleOOPObjectPool::PoolStatistics() noexcept {
+    return pool().statistics();
+}
+
+tsmoreland::interop::latency_summary CSimpleOOPObjectPool::ActivationLatency() noexcept {
+    return activation_latency().summary();
+}
@@ -0,0 +1,85 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include "TSMoreland.Interop.Portable/latency_histogram.h"
+#include "TSMoreland.Interop.Portable/object_pool.h"
+
+/// <summary>
+/// class factory for SimpleOOPObject, activates instances through <see cref="CSimpleOOPObjectPool"/> when pooling
+/// is enabled and as CComClassFactory otherwise
+/// </summary>
+class CSimpleOOPObjectFactory : public ATL::CComClassFactory {
+public:
+    STDMETHOD(CreateInstance)(LPUNKNOWN outer, REFIID riid, void** object) override;
+};
+
+/// <summary>
+/// process wide pool of SimpleOOPObject instances; a released instance is reset and kept for the next activation
+/// while the pool has room, otherwise it's destroyed.  Pooling is off until <see cref="Configure"/> is given a size
+/// </summary>
+class CSimpleOOPObjectPool final {
+public:
+    struct options {
+        std::size_t size{};
+        std::size_t warm_up{};
+    };
+
+    CSimpleOOPObjectPool() = delete;
+
+    /// <summary>
+    /// reads the pool options from the server command line, as -PoolSize=N and -WarmUp=N (or with /), ignoring
+    /// any other argument
+    /// </summary>
+    [[nodiscard]]
+    static options ParseCommandLine(LPCWSTR command_line) noexcept;
+
+    /// <summary>
+    /// sets the number of idle instances kept and creates up to <c>warm_up</c> of them now, so the first
+    /// activations don't pay for construction; a size of 0 leaves pooling off
+    /// </summary>
+    /// <returns>S_OK on success, otherwise the failure from constructing or storing an instance</returns>
+    static HRESULT Configure(options const& settings) noexcept;
+
+    /// <summary>
+    /// takes an idle instance, or creates one if there are none, and queries it for <paramref name="riid"/>
+    /// </summary>
+    static HRESULT Activate(REFIID riid, void** object) noexcept;
+
+    /// <summary>
+    /// destroys the idle instances and turns pooling off, called as the server shuts down
+    /// </summary>
+    static void Drain() noexcept;
+
+    /// <returns>true once <see cref="Configure"/> has been given a non-zero size, until <see cref="Drain"/></returns>
+    [[nodiscard]]
+    static bool Enabled() noexcept;
+
+    /// <summary>
+    /// adds the time taken by an activation made without the pool to <see cref="ActivationLatency"/>
+    /// </summary>
+    static void RecordActivation(std::chrono::nanoseconds elapsed) noexcept;
+
+    [[nodiscard]]
+    static tsmoreland::interop::object_pool_statistics PoolStatistics() noexcept;
+
+    /// <returns>time taken by each activation, from the request reaching the factory to the interface returned</returns>
+    [[nodiscard]]
+    static tsmoreland::interop::latency_summary ActivationLatency() noexcept;
+};
@@ -16,6 +16,16 @@
 // ReSharper disable CppInconsistentNaming
 // ReSharper disable CppPolymorphicClassWithNonVirtualPublicDestructor
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+
+#include "TSMoreland.Interop.Portable/coalescing_dispatcher.h"
+#include "TSMoreland.Interop.Portable/sink_snapshot.h"
+
 using namespace ATL;
 
 template <class T>
@@ -23,33 +33,285 @@ class CProxy_ISimpleOOPObjectEvents // NOLINT(clang-diagnostic-non-virtual-dtor)
     : public IConnectionPointImpl<T, &__uuidof(_ISimpleOOPObjectEvents), CComDynamicUnkArray> {
 
     using base = IConnectionPointImpl<T, &__uuidof(_ISimpleOOPObjectEvents), CComDynamicUnkArray>;
+
+    // mirrors base::m_vec so events can be fired without the object lock, updated under it by Advise and Unadvise
+    tsmoreland::interop::sink_snapshot<ATL::CComPtr<IDispatch>> sinks_;
+
+    // the proxies in sinks_ belong to the server's single threaded apartment and can't be called from the dispatcher
+    // thread, so each sink is also registered in the global interface table under the cookie held here, 0 once
+    // revoked; the dispatcher unmarshals its own proxy from there for every event
+    tsmoreland::interop::sink_snapshot<std::shared_ptr<std::atomic<DWORD>>> global_sinks_;
+
+    // the dispatcher thread joins the multithreaded apartment to unmarshal and call the sinks
+    struct multithreaded_apartment_scope {
+        HRESULT const result{::CoInitializeEx(nullptr, COINIT_MULTITHREADED)};
+
+        ~multithreaded_apartment_scope() {
+            if (SUCCEEDED(result)) {
+                ::CoUninitialize();
+            }
+        }
+    };
+
+    using event_dispatcher = tsmoreland::interop::coalescing_dispatcher<std::wstring, multithreaded_apartment_scope>;
+
+    // distinct property names waiting for delivery before further changes are dropped
+    static constexpr std::size_t async_event_capacity = 64;
+
+    // null unless async events are enabled, declared after sinks_ so it's stopped before they're released
+    std::atomic<std::shared_ptr<event_dispatcher>> dispatcher_;
+
 public:
+    STDMETHOD(Advise)(IUnknown* sink, DWORD* cookie) override {
+        T* p_this = static_cast<T*>(this);
+        typename T::ObjectLock const lock{p_this};
+
+        HRESULT const hr = base::Advise(sink, cookie);
+        if (FAILED(hr)) {
+            return hr;
+        }
+
+        // base::Advise queried the sink for the events dispinterface, the stored pointer is an IDispatch
+        auto* const dispatch = static_cast<IDispatch*>(base::m_vec.GetUnknown(*cookie));
+
+        ATL::CComPtr<IGlobalInterfaceTable> table;
+        DWORD registration{};
+        HRESULT result = GlobalInterfaceTable(&table);
+        if (SUCCEEDED(result)) {
+            result = table->RegisterInterfaceInGlobal(dispatch, IID_IDispatch, &registration);
+        }
+        if (SUCCEEDED(result)) {
+            try {
+                global_sinks_.add(*cookie, std::make_shared<std::atomic<DWORD>>(registration));
+            } catch (std::bad_alloc const&) {
+                table->RevokeInterfaceFromGlobal(registration);
+                result = E_OUTOFMEMORY;
+            }
+        }
+        if (SUCCEEDED(result)) {
+            try {
+                sinks_.add(*cookie, dispatch);
+            } catch (std::bad_alloc const&) {
+                RevokeGlobal(*cookie);
+                result = E_OUTOFMEMORY;
+            }
+        }
+        if (FAILED(result)) {
+            base::Unadvise(*cookie);
+            *cookie = 0;
+        }
+        return result;
+    }
+
+    STDMETHOD(Unadvise)(DWORD cookie) override {
+        T* p_this = static_cast<T*>(this);
+        typename T::ObjectLock const lock{p_this};
+
+        // removed from the snapshot first, it's the only step that can fail
+        try {
+            sinks_.remove(cookie);
+        } catch (std::bad_alloc const&) {
+            return E_OUTOFMEMORY;
+        }
+        RevokeGlobal(cookie);
+        return base::Unadvise(cookie);
+    }
+
+    /// <summary>
+    /// calls OnPropertyChanaged on each connected sink
+    /// </summary>
+    /// <remarks>
+    /// takes no lock, the sinks are read from an immutable snapshot and every sink is passed the same parameters;
+    /// <paramref name="propertyName"/> is borrowed, not copied or freed
+    /// </remarks>
     HRESULT Fire_OnPropertyChanaged(BSTR propertyName) {
-        T* p_this      = static_cast<T*>(this);
+        auto const snapshot = sinks_.snapshot();
+        if (snapshot->empty()) {
+            return S_OK;
+        }
 
-        for (int i = 0, size = base::m_vec.GetSize(); i < size; i++) {
+        VARIANTARG parameter{};
+        parameter.vt      = VT_BSTR;
+        parameter.bstrVal = propertyName;
+        DISPPARAMS params = {&parameter, nullptr, 1, 0};
 
-            p_this->Lock();
-            ATL::CComPtr<IUnknown> const unknown = base::m_vec.GetAt(i);
-            p_this->Unlock();
+        for (auto const& [cookie, dispatch] : *snapshot) {
+            InvokeOnPropertyChanaged(dispatch, params);
+        }
+        return S_OK;
+    }
 
-            if (auto const dispatch = reinterpret_cast<IDispatch*>(unknown.p);
-                dispatch != nullptr) {
+    /// <summary>
+    /// calls OnPropertyChanaged on each connected sink, as <see cref="Fire_OnPropertyChanaged"/> or, when async
+    /// events are enabled, later from the dispatcher thread coalesced with other changes to the same property
+    /// </summary>
+    /// <returns>S_OK on success; otherwise E_OUTOFMEMORY if the event can't be queued</returns>
+    HRESULT Post_OnPropertyChanaged(BSTR propertyName) {
+        if (sinks_.snapshot()->empty()) {
+            return S_OK;
+        }
 
-                constexpr DISPID disp_id = 1; // see IDL file for id value
-                ATL::CComVariant parameters[1] = {ATL::CComVariant(propertyName)};
-                ATL::CComVariant result{};
-                DISPPARAMS params = {parameters, nullptr, 1, 0};
-                dispatch->Invoke(
-                    disp_id,
-                    IID_NULL,
-                    LOCALE_USER_DEFAULT,
-                    DISPATCH_METHOD,
-                    &params,
-                    &result,
-                    nullptr, nullptr);
+        auto const dispatcher = dispatcher_.load(std::memory_order_acquire);
+        if (dispatcher == nullptr) {
+            return Fire_OnPropertyChanaged(propertyName);
+        }
+        try {
+            dispatcher->post(std::wstring{propertyName, ::SysStringLen(propertyName)});
+        } catch (std::bad_alloc const&) {
+            return E_OUTOFMEMORY;
+        }
+        return S_OK;
+    }
+
+    /// <summary>
+    /// starts or stops the dispatcher thread used by <see cref="Post_OnPropertyChanaged"/>, stopping delivers the
+    /// events already queued first
+    /// </summary>
+    /// <returns>
+    /// S_OK on success; otherwise E_OUTOFMEMORY if the dispatcher can't be allocated or E_FAIL if its thread can't
+    /// be started
+    /// </returns>
+    HRESULT EnableAsyncEvents(bool const enabled) {
+        std::shared_ptr<event_dispatcher> previous;
+        {
+            T* p_this = static_cast<T*>(this);
+            typename T::ObjectLock const lock{p_this};
+
+            if (enabled == (dispatcher_.load(std::memory_order_acquire) != nullptr)) {
+                return S_OK;
+            }
+            if (!enabled) {
+                previous = dispatcher_.exchange(nullptr, std::memory_order_acq_rel);
+            } else {
+                try {
+                    dispatcher_.store(std::make_shared<event_dispatcher>(async_event_capacity,
+                        [this](std::wstring const& name) {
+                            FireFromDispatcher(ATL::CComBSTR{static_cast<int>(name.size()), name.c_str()});
+                        }), std::memory_order_release);
+                } catch (std::bad_alloc const&) {
+                    return E_OUTOFMEMORY;
+                } catch (std::system_error const&) {
+                    return E_FAIL;
+                }
+                return S_OK;
             }
         }
+
+        // stopped outside the object lock, a sink being called may call back into the object
+        previous->stop();
         return S_OK;
     }
+
+    /// <summary>
+    /// stops async events and disconnects every sink, leaving the connection point as it was when the object was
+    /// created so the object can be handed out again
+    /// </summary>
+    void ResetConnections() noexcept {
+        EnableAsyncEvents(false);
+
+        T* p_this = static_cast<T*>(this);
+        typename T::ObjectLock const lock{p_this};
+
+        sinks_.clear();
+        for (auto const& [cookie, registration] : *global_sinks_.snapshot()) {
+            RevokeGlobal(*registration);
+        }
+        global_sinks_.clear();
+        for (IUnknown** sink = base::m_vec.begin(); sink < base::m_vec.end(); sink++) {
+            if (*sink != nullptr) {
+                (*sink)->Release();
+            }
+        }
+        base::m_vec.clear();
+    }
+
+    [[nodiscard]]
+    bool AsyncEventsEnabled() const noexcept {
+        return dispatcher_.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /// <returns>the counters of the current dispatcher, all 0 when async events are disabled</returns>
+    [[nodiscard]]
+    tsmoreland::interop::dispatcher_statistics AsyncEventStatistics() const {
+        auto const dispatcher = dispatcher_.load(std::memory_order_acquire);
+        return dispatcher != nullptr ? dispatcher->statistics() : tsmoreland::interop::dispatcher_statistics{};
+    }
+
+private:
+    static HRESULT GlobalInterfaceTable(IGlobalInterfaceTable** table) noexcept {
+        return ::CoCreateInstance(CLSID_StdGlobalInterfaceTable, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(table));
+    }
+
+    static void InvokeOnPropertyChanaged(IDispatch* const sink, DISPPARAMS& params) noexcept {
+        constexpr DISPID disp_id = 1; // see IDL file for id value
+        ATL::CComVariant result{};
+        sink->Invoke(
+            disp_id,
+            IID_NULL,
+            LOCALE_USER_DEFAULT,
+            DISPATCH_METHOD,
+            &params,
+            &result,
+            nullptr, nullptr);
+    }
+
+    /// <summary>
+    /// calls OnPropertyChanaged on each connected sink from the dispatcher thread, through a proxy unmarshaled from
+    /// the global interface table into the dispatcher's apartment
+    /// </summary>
+    /// <remarks>sinks which are unadvised while the event is delivered may or may not be called</remarks>
+    void FireFromDispatcher(BSTR propertyName) noexcept {
+        auto const snapshot = global_sinks_.snapshot();
+        ATL::CComPtr<IGlobalInterfaceTable> table;
+        if (snapshot->empty() || FAILED(GlobalInterfaceTable(&table))) {
+            return;
+        }
+
+        VARIANTARG parameter{};
+        parameter.vt      = VT_BSTR;
+        parameter.bstrVal = propertyName;
+        DISPPARAMS params = {&parameter, nullptr, 1, 0};
+
+        for (auto const& [cookie, registration] : *snapshot) {
+            DWORD const global_cookie = registration->load(std::memory_order_acquire);
+            ATL::CComPtr<IDispatch> dispatch;
+            // fails if the sink was unadvised since the snapshot was taken
+            if (global_cookie == 0 || FAILED(table->GetInterfaceFromGlobal(global_cookie, IID_PPV_ARGS(&dispatch)))) {
+                continue;
+            }
+            InvokeOnPropertyChanaged(dispatch, params);
+        }
+    }
+
+    /// <summary>
+    /// revokes the global interface table entry of <paramref name="registration"/>, once
+    /// </summary>
+    static void RevokeGlobal(std::atomic<DWORD>& registration) noexcept {
+        DWORD const global_cookie = registration.exchange(0, std::memory_order_acq_rel);
+        ATL::CComPtr<IGlobalInterfaceTable> table;
+        if (global_cookie != 0 && SUCCEEDED(GlobalInterfaceTable(&table))) {
+            table->RevokeInterfaceFromGlobal(global_cookie);
+        }
+    }
+
+    /// <summary>
+    /// revokes the global interface table entry of the sink connected under <paramref name="cookie"/> and removes it
+    /// from <see cref="global_sinks_"/>
+    /// </summary>
+    /// <remarks>
+    /// the entry is revoked before it's removed, if removing it fails the dispatcher skips it until the connection
+    /// point is reset
+    /// </remarks>
+    void RevokeGlobal(DWORD const cookie) noexcept {
+        for (auto const& [connected, registration] : *global_sinks_.snapshot()) {
+            if (connected == cookie) {
+                RevokeGlobal(*registration);
+            }
+        }
+        try {
+            global_sinks_.remove(cookie);
+        } catch (std::bad_alloc const&) {
+            // left in place with a cookie of 0
+        }
+    }
 };
@@ -9,6 +9,7 @@
 #include "resource.h"
 #include "SimpleOutOfProcessCOM_i.h"
 #include "xdlldata.h"
+#include "SimpleOOPObjectPool.h"
 
 
 using namespace ATL;
@@ -19,6 +20,21 @@ class CSimpleOutOfProcessCOMModule : public ATL::CAtlExeModuleT< CSimpleOutOfPro
 public :
 	DECLARE_LIBID(LIBID_SimpleOutOfProcessCOMLib)
 	DECLARE_REGISTRY_APPID_RESOURCEID(IDR_SIMPLEOUTOFPROCESSCOM, "{4faab4cd-f38e-4709-a0e3-b15763ec7452}")
+
+	// true when the server should run, false for /RegServer, /UnregServer and the like; pooling is only configured
+	// in the former and stays off unless the command line passes -PoolSize=N, optionally with -WarmUp=N
+	bool ParseCommandLine(LPCTSTR lpCmdLine, HRESULT* pnRetCode) throw()
+	{
+		if (!CAtlExeModuleT::ParseCommandLine(lpCmdLine, pnRetCode)) {
+			return false;
+		}
+
+		CSimpleOOPObjectPool::options const settings = CSimpleOOPObjectPool::ParseCommandLine(lpCmdLine);
+		if (settings.size != 0 && FAILED(CSimpleOOPObjectPool::Configure(settings))) {
+			CSimpleOOPObjectPool::Drain();
+		}
+		return true;
+	}
 };
 
 CSimpleOutOfProcessCOMModule _AtlModule;
@@ -30,6 +46,9 @@ CSimpleOutOfProcessCOMModule _AtlModule;
 extern "C" int WINAPI _tWinMain(HINSTANCE /*hInstance*/, HINSTANCE /*hPrevInstance*/,
 								LPTSTR /*lpCmdLine*/, int nShowCmd)
 {
-	return _AtlModule.WinMain(nShowCmd);
+	// the pool is configured, if at all, by ParseCommandLine above as WinMain starts the server
+	int const result = _AtlModule.WinMain(nShowCmd);
+	CSimpleOOPObjectPool::Drain();
+	return result;
 }
 
@@ -10,7 +10,10 @@
 // add headers that you want to pre-compile here
 #include "framework.h"
 
+#include <atlsafe.h>
+
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <ranges>
 #include <string>
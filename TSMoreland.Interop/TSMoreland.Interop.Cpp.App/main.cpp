@@ -13,16 +13,18 @@
 #include <iostream>
 #include <string_view>
 
+#include "TSMoreland.Interop.Portable/guid.h"
+
 #import "libid:580185ad-317a-4eb7-a6ab-48ebd08c8407" lcid("0")
 #import "libid:4faab4cd-f38e-4709-a0e3-b15763ec7452" lcid("0")
 
-GUID uuid_from_string(char const* source);
-
+using namespace tsmoreland::interop::literals;
+using tsmoreland::interop::to_win32;
 
 int main() {
 
-    GUID const in_process_id{uuid_from_string("e3d3572d-9e25-4cf3-82f5-45b6f0035a82")};
-    GUID const events_id{uuid_from_string("71A4D526-4FAD-4D4B-8A6E-78AFCABD7F63")};
+    constexpr GUID in_process_id{to_win32("e3d3572d-9e25-4cf3-82f5-45b6f0035a82"_guid)};
+    constexpr GUID events_id{to_win32("71A4D526-4FAD-4D4B-8A6E-78AFCABD7F63"_guid)};
 
     SimpleInProcessCOMLib::_ISimpleObjectEventsPtr events_ptr;
     SimpleInProcessCOMLib::ISimpleObject2Ptr simple_object{};
@@ -41,14 +43,3 @@ int main() {
 
     return 0;
 }
-
-GUID uuid_from_string(char const* source) {
-
-	GUID guid;
-	sscanf_s(source,
-        "{%8x-%4hx-%4hx-%2hhx%2hhx-%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx}",
-        &guid.Data1, &guid.Data2, &guid.Data3, &guid.Data4[0],
-        &guid.Data4[1], &guid.Data4[2], &guid.Data4[3],
-        &guid.Data4[4], &guid.Data4[5], &guid.Data4[6], &guid.Data4[7] );
-    return guid;
-}
@@ -0,0 +1,93 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+#include <Windows.h>
+
+namespace tsmoreland::interop::benchmarks {
+
+    using benchmark_clock = std::chrono::steady_clock;
+    using arguments       = std::span<char* const>;
+
+    /// <summary>
+    /// forces <paramref name="value"/> to be read so the optimizer can't discard the work that produced it
+    /// </summary>
+    template <typename T>
+    void do_not_optimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static void const* volatile sink;
+        sink = &value;
+#endif
+    }
+
+    /// <summary>
+    /// runs <paramref name="func"/> <paramref name="repetitions"/> times returning the fastest run in nanoseconds
+    /// </summary>
+    template <typename Func>
+    [[nodiscard]]
+    double best_of_ns(int const repetitions, Func&& func) {
+        double best = std::numeric_limits<double>::max();
+        for (int i = 0; i < repetitions; i++) {
+            auto const start = benchmark_clock::now();
+            func();
+            std::chrono::duration<double, std::nano> const elapsed = benchmark_clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    }
+
+    /// <summary>
+    /// throws if <paramref name="hr"/> is a failure so a benchmark stops at the first failed call
+    /// </summary>
+    inline void throw_if_failed(HRESULT const hr, char const* const what) {
+        if (FAILED(hr)) {
+            char message[128]{};
+            std::snprintf(message, sizeof(message), "%s failed with 0x%08lX", what, static_cast<unsigned long>(hr));
+            throw std::runtime_error(message);
+        }
+    }
+
+    /// <summary>
+    /// joins the calling thread to the multithreaded apartment for its lifetime; both servers are registered as
+    /// Both so the in process object is created in it and called directly, from any thread that has joined it
+    /// </summary>
+    class com_apartment final {
+    public:
+        com_apartment() {
+            throw_if_failed(::CoInitializeEx(nullptr, COINIT_MULTITHREADED), "CoInitializeEx");
+        }
+        com_apartment(com_apartment const&)            = delete;
+        com_apartment& operator=(com_apartment const&) = delete;
+        ~com_apartment() {
+            ::CoUninitialize();
+        }
+    };
+
+    int immutable_properties_benchmark(arguments args);
+    int numeric_contention_benchmark(arguments args);
+    int to_upper_many_benchmark(arguments args);
+
+} // namespace tsmoreland::interop::benchmarks
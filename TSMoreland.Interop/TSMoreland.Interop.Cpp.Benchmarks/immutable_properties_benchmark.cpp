@@ -0,0 +1,148 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <atlbase.h>
+#include <comdef.h>
+
+#include "TSMoreland.Interop.Portable/guid.h"
+#include "benchmark.h"
+
+#import "libid:4faab4cd-f38e-4709-a0e3-b15763ec7452" lcid("0")
+
+using namespace tsmoreland::interop::literals;
+
+namespace tsmoreland::interop::benchmarks {
+
+    namespace {
+        using object_ptr = SimpleOutOfProcessCOMLib::ISimpleOOPObject3Ptr;
+
+        struct immutable_properties {
+            CComBSTR name;
+            GUID id{};
+            CComBSTR description;
+        };
+
+        /// <summary>
+        /// reads each property from the server every time it's asked for, one round trip per property
+        /// </summary>
+        class remote_properties final {
+        public:
+            explicit remote_properties(object_ptr object) : object_{std::move(object)} {}
+
+            /// <returns>the round trips made</returns>
+            long long read(immutable_properties& properties) {
+                properties.name.Empty();
+                properties.description.Empty();
+                throw_if_failed(object_->get_Name(&properties.name), "get_Name");
+                throw_if_failed(object_->get_Id(&properties.id), "get_Id");
+                throw_if_failed(object_->get_Description(&properties.description), "get_Description");
+                return 3;
+            }
+
+        private:
+            object_ptr object_;
+        };
+
+        /// <summary>
+        /// client side snapshot: the properties are fetched with one GetImmutableProperties call when the snapshot
+        /// is created and read locally afterwards, Numeric and ToUpper would still go to the server
+        /// </summary>
+        class snapshot_properties final {
+        public:
+            explicit snapshot_properties(object_ptr const& object) {
+                throw_if_failed(object->raw_GetImmutableProperties(&snapshot_.name, &snapshot_.id,
+                    &snapshot_.description), "GetImmutableProperties");
+            }
+
+            /// <returns>the round trips made, always 0</returns>
+            long long read(immutable_properties& properties) const {
+                properties.name        = snapshot_.name;
+                properties.id          = snapshot_.id;
+                properties.description = snapshot_.description;
+                return 0;
+            }
+
+        private:
+            immutable_properties snapshot_;
+        };
+
+        struct read_result {
+            double first_read_ns;
+            double ns_per_read;
+            double round_trips_per_read;
+        };
+
+        /// <summary>
+        /// creates a Properties for a new object and reads all three properties <paramref name="reads"/> times,
+        /// the first read including the cost of creating the Properties
+        /// </summary>
+        template <typename Properties>
+        read_result measure(int const reads) {
+            constexpr GUID out_of_process_id{to_win32("972b85e9-b7c9-467e-9c38-da5423ebcb1e"_guid)};
+            object_ptr object{};
+            throw_if_failed(object.CreateInstance(out_of_process_id, nullptr, CLSCTX_LOCAL_SERVER), "CreateInstance");
+
+            immutable_properties properties;
+            long long round_trips = 0;
+            auto const start      = benchmark_clock::now();
+            Properties source{object};
+            round_trips += source.read(properties);
+            std::chrono::duration<double, std::nano> const first_read = benchmark_clock::now() - start;
+
+            double const elapsed_ns = best_of_ns(1, [&] {
+                for (int i = 1; i < reads; i++) {
+                    round_trips += source.read(properties);
+                    do_not_optimize(properties);
+                }
+            });
+
+            // the creation of a snapshot is a round trip too
+            if constexpr (std::is_same_v<Properties, snapshot_properties>) {
+                round_trips++;
+            }
+            return {first_read.count(), (first_read.count() + elapsed_ns) / reads,
+                static_cast<double>(round_trips) / reads};
+        }
+
+        void report(char const* const method, read_result const& result) {
+            std::printf("%-10s %16.2f %16.0f %14.0f\n", method, result.round_trips_per_read, result.first_read_ns,
+                result.ns_per_read);
+        }
+    } // namespace
+
+    /// <summary>
+    /// reads Name, Id and Description of an out of process object repeatedly, with a call per property each time
+    /// and from a client side snapshot taken with one GetImmutableProperties call, reporting the round trips and
+    /// latency per read
+    /// </summary>
+    /// <param name="args">optional number of reads, default 10000</param>
+    int immutable_properties_benchmark(arguments const args) {
+        int const reads = std::max(1, args.size() > 0 ? std::stoi(args[0]) : 10'000);
+
+        std::printf("reads of Name, Id and Description: %d\n", reads);
+        std::printf("%-10s %16s %16s %14s\n", "reads from", "round trips/read", "first read ns", "ns/read");
+        report("server", measure<remote_properties>(reads));
+        report("snapshot", measure<snapshot_properties>(reads));
+        return 0;
+    }
+
+} // namespace tsmoreland::interop::benchmarks
@@ -0,0 +1,63 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <iostream>
+#include <string_view>
+
+#include "benchmark.h"
+
+namespace benchmarks = tsmoreland::interop::benchmarks;
+
+struct benchmark_entry {
+    std::string_view name;
+    int (*run)(benchmarks::arguments);
+};
+
+constexpr benchmark_entry available_benchmarks[] = {
+    {"immutable_properties", benchmarks::immutable_properties_benchmark},
+    {"numeric_contention", benchmarks::numeric_contention_benchmark},
+    {"to_upper_many", benchmarks::to_upper_many_benchmark},
+};
+
+int main(int argc, char* argv[]) {
+    benchmarks::arguments const args{argv, static_cast<std::size_t>(argc)};
+
+    if (args.size() < 2) {
+        std::cout << "usage: " << args[0] << " <benchmark> [arguments...]\n\navailable benchmarks:\n";
+        for (auto const& [name, run] : available_benchmarks) {
+            std::cout << "    " << name << "\n";
+        }
+        return 1;
+    }
+
+    std::string_view const requested{args[1]};
+    for (auto const& [name, run] : available_benchmarks) {
+        if (name != requested) {
+            continue;
+        }
+
+        try {
+            benchmarks::com_apartment const apartment;
+            return run(args.subspan(2));
+        } catch (std::exception const& ex) {
+            std::cout << ex.what() << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << "unknown benchmark " << requested << "\n";
+    return 1;
+}
@@ -0,0 +1,173 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <atlbase.h>
+#include <comdef.h>
+
+#include "TSMoreland.Interop.Portable/guid.h"
+#include "benchmark.h"
+
+#import "libid:580185ad-317a-4eb7-a6ab-48ebd08c8407" lcid("0")
+#import "libid:4faab4cd-f38e-4709-a0e3-b15763ec7452" lcid("0")
+
+using namespace tsmoreland::interop::literals;
+
+namespace tsmoreland::interop::benchmarks {
+
+    namespace {
+        enum class increment_strategy {
+            get_then_put,
+            compare_exchange,
+            add,
+        };
+
+        constexpr std::pair<char const*, increment_strategy> strategies[] = {
+            {"get + put", increment_strategy::get_then_put},
+            {"compare exchange", increment_strategy::compare_exchange},
+            {"AddNumeric", increment_strategy::add},
+        };
+
+        /// <summary>
+        /// adds 1 to Numeric using <paramref name="strategy"/>, returning the number of calls it took
+        /// </summary>
+        template <typename ObjectPtr>
+        long long increment(ObjectPtr const& object, increment_strategy const strategy) {
+            LONG value{};
+            switch (strategy) {
+            case increment_strategy::get_then_put:
+                // two round trips with a window between them in which other threads' increments are lost
+                throw_if_failed(object->get_Numeric(&value), "get_Numeric");
+                throw_if_failed(object->put_Numeric(value + 1), "put_Numeric");
+                return 2;
+            case increment_strategy::compare_exchange: {
+                throw_if_failed(object->get_Numeric(&value), "get_Numeric");
+                long long calls = 1;
+                while (true) {
+                    LONG original{};
+                    throw_if_failed(object->raw_CompareExchangeNumeric(value + 1, value, &original),
+                        "CompareExchangeNumeric");
+                    calls++;
+                    if (original == value) {
+                        return calls;
+                    }
+                    value = original;
+                }
+            }
+            case increment_strategy::add:
+            default:
+                throw_if_failed(object->raw_AddNumeric(1, &value), "AddNumeric");
+                return 1;
+            }
+        }
+
+        struct contention_result {
+            double elapsed_ns;
+            long long calls;
+            long long lost;
+        };
+
+        template <typename ObjectPtr>
+        contention_result run_threads(ObjectPtr const& object, increment_strategy const strategy,
+            unsigned const threads, int const increments) {
+            throw_if_failed(object->put_Numeric(0), "put_Numeric");
+
+            std::atomic<long long> calls{0};
+            std::exception_ptr failure;
+            std::atomic_flag failed;
+            double const elapsed_ns = best_of_ns(1, [&] {
+                std::vector<std::thread> workers;
+                for (unsigned t = 0; t < threads; t++) {
+                    workers.emplace_back([&] {
+                        try {
+                            com_apartment const apartment;
+                            long long made = 0;
+                            for (int i = 0; i < increments; i++) {
+                                made += increment(object, strategy);
+                            }
+                            calls.fetch_add(made, std::memory_order_relaxed);
+                        } catch (...) {
+                            if (!failed.test_and_set()) {
+                                failure = std::current_exception();
+                            }
+                        }
+                    });
+                }
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+            });
+            if (failure != nullptr) {
+                std::rethrow_exception(failure);
+            }
+
+            LONG final_value{};
+            throw_if_failed(object->get_Numeric(&final_value), "get_Numeric");
+            long long const expected = static_cast<long long>(threads) * increments;
+            return {elapsed_ns, calls.load(), expected - final_value};
+        }
+
+        template <typename ObjectPtr>
+        void compare(char const* const server, ObjectPtr const& object, unsigned const max_threads,
+            int const increments) {
+            std::printf("\n%s\n", server);
+            std::printf("%-18s %8s %16s %16s %14s\n", "increment", "threads", "increments/s", "calls/increment",
+                "lost updates");
+            for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+                for (auto const& [name, strategy] : strategies) {
+                    auto const [elapsed_ns, calls, lost] = run_threads(object, strategy, threads, increments);
+                    double const total = static_cast<double>(threads) * increments;
+                    std::printf("%-18s %8u %16.0f %16.2f %14lld\n", name, threads, total * 1e9 / elapsed_ns,
+                        static_cast<double>(calls) / total, lost);
+                }
+            }
+        }
+    } // namespace
+
+    /// <summary>
+    /// increments Numeric from 1 up to the hardware thread count of client threads at once, with get_Numeric
+    /// followed by put_Numeric, with a CompareExchangeNumeric retry loop and with AddNumeric, reporting
+    /// throughput, calls made per increment and increments lost, for both servers
+    /// </summary>
+    /// <param name="args">optional increments per thread, default 20000</param>
+    int numeric_contention_benchmark(arguments const args) {
+        int const increments       = args.size() > 0 ? std::stoi(args[0]) : 20'000;
+        unsigned const max_threads = std::max(1U, std::thread::hardware_concurrency());
+
+        constexpr GUID in_process_id{to_win32("e3d3572d-9e25-4cf3-82f5-45b6f0035a82"_guid)};
+        constexpr GUID out_of_process_id{to_win32("972b85e9-b7c9-467e-9c38-da5423ebcb1e"_guid)};
+
+        SimpleInProcessCOMLib::ISimpleObject3Ptr in_process{};
+        throw_if_failed(in_process.CreateInstance(in_process_id, nullptr, CLSCTX_INPROC_SERVER), "CreateInstance");
+        SimpleOutOfProcessCOMLib::ISimpleOOPObject3Ptr out_of_process{};
+        throw_if_failed(
+            out_of_process.CreateInstance(out_of_process_id, nullptr, CLSCTX_LOCAL_SERVER), "CreateInstance");
+
+        std::printf("increments per thread: %d\n", increments);
+        compare("in process", in_process, max_threads, increments);
+        compare("out of process", out_of_process, max_threads, increments);
+        return 0;
+    }
+
+} // namespace tsmoreland::interop::benchmarks
@@ -0,0 +1,123 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <atlbase.h>
+#include <atlsafe.h>
+#include <comdef.h>
+
+#include "TSMoreland.Interop.Portable/guid.h"
+#include "benchmark.h"
+
+#import "libid:580185ad-317a-4eb7-a6ab-48ebd08c8407" lcid("0")
+#import "libid:4faab4cd-f38e-4709-a0e3-b15763ec7452" lcid("0")
+
+using namespace tsmoreland::interop::literals;
+
+namespace tsmoreland::interop::benchmarks {
+
+    namespace {
+        constexpr int repetitions = 3;
+
+        void report(char const* const method, std::size_t const batch_size, std::size_t const count,
+            double const elapsed_ns, double const baseline_ns) {
+            double const calls = static_cast<double>((count + batch_size - 1) / batch_size);
+            std::printf("%-12s %8zu %14.0f %14.0f %8.1fx\n", method, batch_size, calls * 1e9 / elapsed_ns,
+                static_cast<double>(count) * 1e9 / elapsed_ns, baseline_ns / elapsed_ns);
+        }
+
+        /// <summary>
+        /// one ToUpper call per string, then ToUpperMany with the strings split into batches of each size
+        /// </summary>
+        template <typename ObjectPtr>
+        void compare(char const* const server, ObjectPtr const& object, std::vector<CComBSTR> const& inputs,
+            std::span<std::size_t const> const batch_sizes) {
+            std::size_t const count = inputs.size();
+
+            double const single_ns = best_of_ns(repetitions, [&] {
+                for (CComBSTR const& input : inputs) {
+                    BSTR upper{};
+                    throw_if_failed(object->raw_ToUpper(input.m_str, &upper), "ToUpper");
+                    ::SysFreeString(upper);
+                }
+            });
+
+            std::printf("\n%s\n", server);
+            std::printf("%-12s %8s %14s %14s %9s\n", "method", "batch", "calls/s", "strings/s", "speedup");
+            report("ToUpper", 1, count, single_ns, single_ns);
+
+            for (std::size_t const batch_size : batch_sizes) {
+                std::vector<CComSafeArray<BSTR>> batches;
+                batches.reserve((count + batch_size - 1) / batch_size);
+                for (std::size_t offset = 0; offset < count; offset += batch_size) {
+                    std::size_t const size = std::min(batch_size, count - offset);
+                    CComSafeArray<BSTR>& batch = batches.emplace_back(static_cast<ULONG>(size));
+                    for (std::size_t i = 0; i < size; i++) {
+                        throw_if_failed(batch.SetAt(static_cast<LONG>(i), inputs[offset + i].m_str), "SetAt");
+                    }
+                }
+
+                double const batch_ns = best_of_ns(repetitions, [&] {
+                    for (CComSafeArray<BSTR> const& batch : batches) {
+                        SAFEARRAY* upper{};
+                        throw_if_failed(object->raw_ToUpperMany(batch.m_psa, &upper), "ToUpperMany");
+                        ::SafeArrayDestroy(upper);
+                    }
+                });
+                report("ToUpperMany", batch_size, count, batch_ns, single_ns);
+            }
+        }
+    } // namespace
+
+    /// <summary>
+    /// calls and strings per second converting the same strings with one ToUpper call each against batches
+    /// passed to ToUpperMany, for the in process server and the out of process server
+    /// </summary>
+    /// <param name="args">optional number of strings and their length, default 10000 of 32 characters</param>
+    int to_upper_many_benchmark(arguments const args) {
+        std::size_t const count  = args.size() > 0 ? std::stoull(args[0]) : 10'000;
+        std::size_t const length = args.size() > 1 ? std::stoull(args[1]) : 32;
+
+        std::vector<CComBSTR> inputs(count);
+        for (std::size_t i = 0; i < count; i++) {
+            std::wstring text(length, L' ');
+            for (std::size_t j = 0; j < length; j++) {
+                text[j] = static_cast<wchar_t>(L'a' + (i + j) % 26);
+            }
+            inputs[i] = text.c_str();
+        }
+        std::size_t const batch_sizes[] = {16, 256, count};
+
+        constexpr GUID in_process_id{to_win32("e3d3572d-9e25-4cf3-82f5-45b6f0035a82"_guid)};
+        constexpr GUID out_of_process_id{to_win32("972b85e9-b7c9-467e-9c38-da5423ebcb1e"_guid)};
+
+        SimpleInProcessCOMLib::ISimpleObject3Ptr in_process{};
+        throw_if_failed(in_process.CreateInstance(in_process_id, nullptr, CLSCTX_INPROC_SERVER), "CreateInstance");
+        SimpleOutOfProcessCOMLib::ISimpleOOPObject3Ptr out_of_process{};
+        throw_if_failed(
+            out_of_process.CreateInstance(out_of_process_id, nullptr, CLSCTX_LOCAL_SERVER), "CreateInstance");
+
+        std::printf("strings: %zu of %zu characters, best of %d runs\n", count, length, repetitions);
+        compare("in process", in_process, inputs, batch_sizes);
+        compare("out of process", out_of_process, inputs, batch_sizes);
+        return 0;
+    }
+
+} // namespace tsmoreland::interop::benchmarks
@@ -0,0 +1,35 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include "TSMoreland.Interop.Portable.Benchmarks/benchmark_harness.h"
+
+namespace tsmoreland::interop::benchmarks {
+
+    using tsmoreland::benchmarks::arguments;
+    using tsmoreland::benchmarks::benchmark_clock;
+    using tsmoreland::benchmarks::best_of_ns;
+    using tsmoreland::benchmarks::do_not_optimize;
+
+    int case_conversion_benchmark(arguments args);
+    int dispatch_lookup_benchmark(arguments args);
+    int guid_format_benchmark(arguments args);
+    int guid_parse_benchmark(arguments args);
+    int ring_buffer_benchmark(arguments args);
+    int sink_snapshot_benchmark(arguments args);
+
+} // namespace tsmoreland::interop::benchmarks
@@ -0,0 +1,101 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string_view>
+
+namespace tsmoreland::benchmarks {
+
+    using benchmark_clock = std::chrono::steady_clock;
+    using arguments       = std::span<char* const>;
+
+    /// <summary>
+    /// forces <paramref name="value"/> to be read so the optimizer can't discard the work that produced it
+    /// </summary>
+    template <typename T>
+    void do_not_optimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static void const* volatile sink;
+        sink = &value;
+#endif
+    }
+
+    /// <summary>
+    /// runs <paramref name="func"/> <paramref name="repetitions"/> times returning the fastest run in nanoseconds
+    /// </summary>
+    template <typename Func>
+    [[nodiscard]]
+    double best_of_ns(int const repetitions, Func&& func) {
+        double best = std::numeric_limits<double>::max();
+        for (int i = 0; i < repetitions; i++) {
+            auto const start = benchmark_clock::now();
+            func();
+            std::chrono::duration<double, std::nano> const elapsed = benchmark_clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    }
+
+    struct benchmark_entry {
+        std::string_view name;
+        int (*run)(arguments);
+    };
+
+    /// <summary>
+    /// runs the benchmark named by the first argument after the program name, passing it the arguments which follow
+    /// </summary>
+    /// <param name="args">the arguments of main, including the program name</param>
+    /// <returns>
+    /// the benchmark's result; otherwise 1 if no benchmark is named, printing the available benchmarks, if the name
+    /// is unknown or if the benchmark throws
+    /// </returns>
+    inline int run_benchmark(arguments const args, std::span<benchmark_entry const> const available) {
+        if (args.size() < 2) {
+            std::cout << "usage: " << args[0] << " <benchmark> [arguments...]\n\navailable benchmarks:\n";
+            for (auto const& [name, run] : available) {
+                std::cout << "    " << name << "\n";
+            }
+            return 1;
+        }
+
+        std::string_view const requested{args[1]};
+        for (auto const& [name, run] : available) {
+            if (name != requested) {
+                continue;
+            }
+
+            try {
+                return run(args.subspan(2));
+            } catch (std::exception const& ex) {
+                std::cout << ex.what() << "\n";
+                return 1;
+            }
+        }
+
+        std::cout << "unknown benchmark " << requested << "\n";
+        return 1;
+    }
+
+} // namespace tsmoreland::benchmarks
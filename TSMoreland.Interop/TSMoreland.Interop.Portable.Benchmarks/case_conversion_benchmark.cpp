@@ -0,0 +1,139 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <clocale>
+#include <cstdio>
+#include <cwctype>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "TSMoreland.Interop.Portable/case_conversion.h"
+#include "benchmark.h"
+
+namespace tsmoreland::interop::benchmarks {
+
+    namespace {
+        /// <summary>
+        /// the conversion previously used by ToUpper: measure to the terminator, copy, towupper each code unit
+        /// and copy again into the result
+        /// </summary>
+        std::u16string copy_and_towupper(char16_t const* const input) {
+            std::u16string upper{input};
+            std::ranges::for_each(upper, [](char16_t& ch) { ch = static_cast<char16_t>(std::towupper(ch)); });
+            return std::u16string{upper.c_str()};
+        }
+
+        /// <summary>
+        /// <paramref name="count"/> strings of <paramref name="length"/> code units of ASCII text, with each code
+        /// unit replaced by a Latin-1, Cyrillic or Greek letter with probability <paramref name="non_ascii_fraction"/>
+        /// </summary>
+        std::vector<std::u16string> make_inputs(
+            std::size_t const count, std::size_t const length, double const non_ascii_fraction) {
+            constexpr std::u16string_view ascii     = u"the quick brown fox jumps over the lazy dog 0123456789 ";
+            constexpr std::u16string_view non_ascii = u"\u00e9\u00fc\u00f1\u00e7\u0436\u0449\u044f\u03b1\u03c9";
+
+            std::mt19937 engine{42};
+            std::bernoulli_distribution replace{non_ascii_fraction};
+            std::vector<std::u16string> inputs(count);
+            for (auto& input : inputs) {
+                input.resize(length);
+                for (std::size_t i = 0; i < length; i++) {
+                    input[i] = replace(engine) ? non_ascii[engine() % non_ascii.size()]
+                                               : ascii[engine() % ascii.size()];
+                }
+            }
+            return inputs;
+        }
+
+        void report(char const* const name, std::size_t const count, std::size_t const length, double const elapsed_ns,
+            double const baseline_ns) {
+            double const bytes = static_cast<double>(count * length * sizeof(char16_t));
+            std::printf("%-18s %10.1f ns/string %8.2f GB/s %8.1fx\n", name, elapsed_ns / static_cast<double>(count),
+                bytes / elapsed_ns, baseline_ns / elapsed_ns);
+        }
+
+        void run_case(char const* const title, std::vector<std::u16string> const& inputs, std::size_t const length) {
+            constexpr int repetitions = 5;
+            std::size_t const count   = inputs.size();
+
+            std::vector<std::u16string> expected(count);
+            double const baseline_ns = best_of_ns(repetitions, [&] {
+                for (std::size_t i = 0; i < count; i++) {
+                    expected[i] = copy_and_towupper(inputs[i].c_str());
+                }
+                do_not_optimize(expected);
+            });
+
+            std::printf("\n%s\n", title);
+            std::printf("%-18s %18s %13s %9s\n", "conversion", "latency", "throughput", "speedup");
+            report("copy + towupper", count, length, baseline_ns, baseline_ns);
+
+            constexpr std::pair<char const*, simd_kernel> kernels[] = {
+                {"to_upper scalar", simd_kernel::scalar},
+                {"to_upper sse2", simd_kernel::sse2},
+                {"to_upper avx2", simd_kernel::avx2},
+            };
+            std::vector<std::u16string> upper(count);
+            for (auto const& [name, kernel] : kernels) {
+                if (!is_supported(kernel)) {
+                    continue;
+                }
+                double const elapsed_ns = best_of_ns(repetitions, [&] {
+                    for (std::size_t i = 0; i < count; i++) {
+                        // sized once and written once, as ToUpper does with SysAllocStringLen
+                        upper[i] = std::u16string(inputs[i].size(), u'\0');
+                        to_upper(std::u16string_view{inputs[i]}, std::span{upper[i]}, kernel);
+                    }
+                    do_not_optimize(upper);
+                });
+                if (upper != expected) {
+                    throw std::runtime_error(std::string(name) + " and towupper results differ");
+                }
+                report(name, count, length, elapsed_ns, baseline_ns);
+            }
+        }
+    } // namespace
+
+    /// <summary>
+    /// ToUpper's conversion before and after the vectorised, table driven kernel for ASCII, mostly ASCII and
+    /// non-ASCII text
+    /// </summary>
+    /// <remarks>
+    /// towupper is given a UTF-8 locale so it upper cases beyond ASCII and its results can be checked against
+    /// the kernel's
+    /// </remarks>
+    /// <param name="args">optional string length in code units and number of strings, default 64 and 100000</param>
+    int case_conversion_benchmark(arguments const args) {
+        std::size_t const length = args.size() > 0 ? std::stoull(args[0]) : 64;
+        std::size_t const count  = args.size() > 1 ? std::stoull(args[1]) : 100'000;
+
+        if (std::setlocale(LC_CTYPE, "C.UTF-8") == nullptr && std::setlocale(LC_CTYPE, ".UTF8") == nullptr) {
+            throw std::runtime_error("a UTF-8 locale is required to compare with towupper");
+        }
+
+        std::printf("strings: %zu of %zu code units, best of 5 runs\n", count, length);
+        run_case("ascii", make_inputs(count, length, 0.0), length);
+        run_case("1 in 32 non-ascii", make_inputs(count, length, 1.0 / 32), length);
+        run_case("7 in 8 non-ascii", make_inputs(count, length, 7.0 / 8), length);
+        run_case("non-ascii", make_inputs(count, length, 1.0), length);
+        return 0;
+    }
+
+} // namespace tsmoreland::interop::benchmarks
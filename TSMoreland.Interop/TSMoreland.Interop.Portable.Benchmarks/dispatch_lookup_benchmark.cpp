@@ -0,0 +1,170 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "TSMoreland.Interop.Portable/dispatch_table.h"
+#include "benchmark.h"
+
+namespace tsmoreland::interop::benchmarks {
+
+    namespace {
+        // the members of ISimpleOOPObject3
+        constexpr std::array<dispatch_name, 16> members{{
+            {L"Name", 1},
+            {L"Id", 2},
+            {L"Numeric", 3},
+            {L"Description", 4},
+            {L"ToUpper", 5},
+            {L"ToUpperMany", 6},
+            {L"AsyncEvents", 7},
+            {L"GetEventStatistics", 8},
+            {L"AddNumeric", 9},
+            {L"CompareExchangeNumeric", 10},
+            {L"GetStringStatistics", 11},
+            {L"GetActivationStatistics", 12},
+            {L"OpenChannel", 13},
+            {L"ProcessChannel", 14},
+            {L"GetImmutableProperties", 15},
+            {L"GetState", 16},
+        }};
+
+        /// <summary>
+        /// compares each name in turn, as a type library without a name hash does
+        /// </summary>
+        class linear_lookup final {
+        public:
+            [[nodiscard]]
+            std::optional<std::int32_t> find(std::wstring_view const name) const noexcept {
+                for (auto const& member : members) {
+                    if (details::dispatch_names_equal(member.name, name)) {
+                        return member.id;
+                    }
+                }
+                return std::nullopt;
+            }
+        };
+
+        struct case_insensitive_less {
+            using is_transparent = void;
+
+            bool operator()(std::wstring_view const left, std::wstring_view const right) const noexcept {
+                return std::ranges::lexicographical_compare(left, right, [](wchar_t const l, wchar_t const r) {
+                    return details::fold_dispatch_case(l) < details::fold_dispatch_case(r);
+                });
+            }
+        };
+
+        /// <summary>
+        /// a balanced tree ordered ignoring case
+        /// </summary>
+        class map_lookup final {
+        public:
+            map_lookup() {
+                for (auto const& [name, id] : members) {
+                    ids_.emplace(name, id);
+                }
+            }
+
+            [[nodiscard]]
+            std::optional<std::int32_t> find(std::wstring_view const name) const {
+                auto const found = ids_.find(name);
+                return found != ids_.end() ? std::optional{found->second} : std::nullopt;
+            }
+
+        private:
+            std::map<std::wstring_view, std::int32_t, case_insensitive_less> ids_;
+        };
+
+        class perfect_hash_lookup final {
+        public:
+            [[nodiscard]]
+            std::optional<std::int32_t> find(std::wstring_view const name) const noexcept {
+                return ids_.find(name);
+            }
+
+        private:
+            static constexpr perfect_hash_map ids_{members};
+        };
+
+        /// <returns>nanoseconds per lookup of each query</returns>
+        template <typename Lookup>
+        double measure(std::vector<std::wstring> const& queries, int const rounds) {
+            Lookup const lookup{};
+            std::int64_t found = 0;
+            double const elapsed_ns = best_of_ns(3, [&] {
+                for (int round = 0; round < rounds; round++) {
+                    for (std::wstring const& query : queries) {
+                        auto const id = lookup.find(query);
+                        found += id.value_or(0);
+                        do_not_optimize(id);
+                    }
+                }
+            });
+            do_not_optimize(found);
+            return elapsed_ns / (static_cast<double>(queries.size()) * rounds);
+        }
+    } // namespace
+
+    /// <summary>
+    /// GetIDsOfNames lookups of the ISimpleOOPObject3 member names, as declared, lower case and misspelt, by a
+    /// linear scan, a case insensitive std::map and the compile time perfect hash
+    /// </summary>
+    /// <param name="args">optional rounds over the queries, default 200000</param>
+    int dispatch_lookup_benchmark(arguments const args) {
+        int const rounds = args.size() > 0 ? std::stoi(args[0]) : 200'000;
+
+        std::vector<std::wstring> queries;
+        for (auto const& [name, id] : members) {
+            std::wstring lower{name};
+            std::ranges::transform(lower, lower.begin(), [](wchar_t const unit) {
+                return unit >= L'A' && unit <= L'Z' ? static_cast<wchar_t>(unit + (L'a' - L'A')) : unit;
+            });
+            queries.emplace_back(name);
+            queries.push_back(lower);
+            queries.push_back(std::wstring{name} + L"x");
+        }
+
+        linear_lookup const linear;
+        map_lookup const map;
+        perfect_hash_lookup const perfect;
+        for (std::wstring const& query : queries) {
+            if (linear.find(query) != perfect.find(query) || map.find(query) != perfect.find(query)) {
+                throw std::runtime_error("lookups disagree");
+            }
+        }
+
+        double const linear_ns  = measure<linear_lookup>(queries, rounds);
+        double const map_ns     = measure<map_lookup>(queries, rounds);
+        double const perfect_ns = measure<perfect_hash_lookup>(queries, rounds);
+
+        std::printf("members: %zu, queries: %zu, rounds: %d, best of 3 runs\n", members.size(), queries.size(), rounds);
+        std::printf("%-14s %12s %9s\n", "lookup", "ns/lookup", "speedup");
+        std::printf("%-14s %12.2f %8.1fx\n", "linear", linear_ns, 1.0);
+        std::printf("%-14s %12.2f %8.1fx\n", "std::map", map_ns, linear_ns / map_ns);
+        std::printf("%-14s %12.2f %8.1fx\n", "perfect hash", perfect_ns, linear_ns / perfect_ns);
+        return 0;
+    }
+
+} // namespace tsmoreland::interop::benchmarks
@@ -0,0 +1,136 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "TSMoreland.Interop.Portable/guid.h"
+#include "benchmark.h"
+
+#ifdef _WIN32
+#include <oleauto.h>
+#include <rpc.h>
+#pragma comment(lib, "oleaut32.lib")
+#pragma comment(lib, "rpcrt4.lib")
+#endif
+
+namespace tsmoreland::interop::benchmarks {
+
+    namespace {
+        /// <summary>
+        /// portable stand in for the previous ConvertToString: format into a temporary allocation, copy that into
+        /// the result, then free the temporary
+        /// </summary>
+        std::string snprintf_format(guid const& value) {
+            auto const temporary = std::make_unique<char[]>(guid_string_length + 1);
+            std::snprintf(temporary.get(), guid_string_length + 1, "%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+                value.data1, value.data2, value.data3, value.data4[0], value.data4[1], value.data4[2], value.data4[3],
+                value.data4[4], value.data4[5], value.data4[6], value.data4[7]);
+            return std::string{temporary.get()};
+        }
+
+        std::string table_format(guid const& value) {
+            std::string text(guid_string_length, '\0');
+            format_guid(value, std::span<char, guid_string_length>{text.data(), guid_string_length});
+            return text;
+        }
+
+        void report(
+            char const* const name, std::size_t const count, double const elapsed_ns, double const baseline_ns) {
+            std::printf("%-22s %10.1f ns/guid %10.1f M guid/s %8.1fx\n", name, elapsed_ns / static_cast<double>(count),
+                static_cast<double>(count) * 1e3 / elapsed_ns, baseline_ns / elapsed_ns);
+        }
+    } // namespace
+
+    /// <summary>
+    /// formatting throughput of <see cref="format_guid"/> writing into the result once against formatting into a
+    /// temporary and copying, with snprintf and, on Windows, UuidToStringW into a BSTR as ConvertToString did
+    /// </summary>
+    /// <param name="args">optional number of distinct GUIDs formatted per run, defaults to 1000000</param>
+    int guid_format_benchmark(arguments const args) {
+        std::size_t const count   = args.empty() ? 1'000'000 : std::stoull(args[0]);
+        constexpr int repetitions = 5;
+
+        std::mt19937_64 engine{42};
+        std::vector<guid> values(count);
+        for (auto& value : values) {
+            auto const high = engine();
+            auto const low  = engine();
+            value.data1     = static_cast<std::uint32_t>(high >> 32);
+            value.data2     = static_cast<std::uint16_t>(high >> 16);
+            value.data3     = static_cast<std::uint16_t>(high);
+            std::memcpy(value.data4.data(), &low, sizeof(low));
+        }
+
+        std::vector<std::string> expected(count);
+        std::vector<std::string> formatted(count);
+        double const snprintf_ns = best_of_ns(repetitions, [&] {
+            for (std::size_t i = 0; i < count; i++) {
+                expected[i] = snprintf_format(values[i]);
+            }
+            do_not_optimize(expected);
+        });
+        double const table_ns = best_of_ns(repetitions, [&] {
+            for (std::size_t i = 0; i < count; i++) {
+                formatted[i] = table_format(values[i]);
+            }
+            do_not_optimize(formatted);
+        });
+        if (formatted != expected) {
+            throw std::runtime_error("format_guid and snprintf results differ");
+        }
+
+        std::printf("guids: %zu, best of %d runs\n", count, repetitions);
+        std::printf("%-22s %18s %19s %9s\n", "formatter", "latency", "throughput", "speedup");
+        report("snprintf + copy", count, snprintf_ns, snprintf_ns);
+        report("format_guid", count, table_ns, snprintf_ns);
+#ifdef _WIN32
+        std::vector<BSTR> strings(count);
+        double const uuid_to_string_ns = best_of_ns(repetitions, [&] {
+            for (std::size_t i = 0; i < count; i++) {
+                GUID const id = to_win32(values[i]);
+                RPC_WSTR text{};
+                UuidToStringW(&id, &text);
+                strings[i] = ::SysAllocString(reinterpret_cast<wchar_t const*>(text));
+                RpcStringFreeW(&text);
+            }
+            do_not_optimize(strings);
+            for (BSTR const text : strings) {
+                ::SysFreeString(text);
+            }
+        });
+        double const bstr_ns = best_of_ns(repetitions, [&] {
+            for (std::size_t i = 0; i < count; i++) {
+                strings[i] = ::SysAllocStringLen(nullptr, static_cast<UINT>(guid_string_length));
+                format_guid(values[i], std::span<wchar_t, guid_string_length>{strings[i], guid_string_length});
+            }
+            do_not_optimize(strings);
+            for (BSTR const text : strings) {
+                ::SysFreeString(text);
+            }
+        });
+        report("UuidToStringW + BSTR", count, uuid_to_string_ns, snprintf_ns);
+        report("format_guid into BSTR", count, bstr_ns, snprintf_ns);
+#endif
+        return 0;
+    }
+
+} // namespace tsmoreland::interop::benchmarks
@@ -0,0 +1,113 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "TSMoreland.Interop.Portable/guid.h"
+#include "benchmark.h"
+
+#ifdef _WIN32
+#include <rpc.h>
+#pragma comment(lib, "rpcrt4.lib")
+#endif
+
+namespace tsmoreland::interop::benchmarks {
+
+    namespace {
+        /// <summary>
+        /// the parser previously used by TSMoreland.Interop.Cpp.App
+        /// </summary>
+        guid sscanf_parse(char const* const text) {
+            unsigned int data1{};
+            unsigned short data2{};
+            unsigned short data3{};
+            unsigned char data4[8]{};
+            if (std::sscanf(text, "%8x-%4hx-%4hx-%2hhx%2hhx-%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx", &data1, &data2, &data3,
+                    &data4[0], &data4[1], &data4[2], &data4[3], &data4[4], &data4[5], &data4[6], &data4[7]) != 11) {
+                throw std::runtime_error("sscanf failed to parse " + std::string(text));
+            }
+            return guid{data1, data2, data3,
+                {data4[0], data4[1], data4[2], data4[3], data4[4], data4[5], data4[6], data4[7]}};
+        }
+
+        void report(
+            char const* const name, std::size_t const count, double const elapsed_ns, double const baseline_ns) {
+            std::printf("%-18s %10.1f ns/guid %10.1f M guid/s %8.1fx\n", name, elapsed_ns / static_cast<double>(count),
+                static_cast<double>(count) * 1e3 / elapsed_ns, baseline_ns / elapsed_ns);
+        }
+    } // namespace
+
+    /// <summary>
+    /// parse throughput of <see cref="try_parse_guid"/> against sscanf and, on Windows, UuidFromStringA
+    /// </summary>
+    /// <param name="args">optional number of distinct GUIDs parsed per run, defaults to 1000000</param>
+    int guid_parse_benchmark(arguments const args) {
+        std::size_t const count   = args.empty() ? 1'000'000 : std::stoull(args[0]);
+        constexpr int repetitions = 5;
+
+        std::mt19937_64 engine{42};
+        std::vector<std::string> texts(count);
+        for (auto& text : texts) {
+            char buffer[40]{};
+            auto const high = engine();
+            auto const low  = engine();
+            std::snprintf(buffer, sizeof(buffer), "%08X-%04X-%04X-%04X-%012llX", static_cast<unsigned>(high >> 32),
+                static_cast<unsigned>(high >> 16) & 0xFFFF, static_cast<unsigned>(high) & 0xFFFF,
+                static_cast<unsigned>(low >> 48), static_cast<unsigned long long>(low & 0xFFFF'FFFF'FFFF));
+            text = buffer;
+        }
+
+        std::vector<guid> parsed(count);
+        std::vector<guid> expected(count);
+
+        double const sscanf_ns = best_of_ns(repetitions, [&] {
+            for (std::size_t i = 0; i < count; i++) {
+                expected[i] = sscanf_parse(texts[i].c_str());
+            }
+            do_not_optimize(expected);
+        });
+        double const parse_ns = best_of_ns(repetitions, [&] {
+            for (std::size_t i = 0; i < count; i++) {
+                parsed[i] = try_parse_guid(texts[i]).value_or(guid{});
+            }
+            do_not_optimize(parsed);
+        });
+        if (parsed != expected) {
+            throw std::runtime_error("try_parse_guid and sscanf results differ");
+        }
+
+        std::printf("guids: %zu, best of %d runs\n", count, repetitions);
+        std::printf("%-18s %18s %19s %9s\n", "parser", "latency", "throughput", "speedup");
+        report("sscanf", count, sscanf_ns, sscanf_ns);
+#ifdef _WIN32
+        std::vector<GUID> uuids(count);
+        double const uuid_from_string_ns = best_of_ns(repetitions, [&] {
+            for (std::size_t i = 0; i < count; i++) {
+                UuidFromStringA(reinterpret_cast<RPC_CSTR>(texts[i].data()), &uuids[i]);
+            }
+            do_not_optimize(uuids);
+        });
+        report("UuidFromStringA", count, uuid_from_string_ns, sscanf_ns);
+#endif
+        report("try_parse_guid", count, parse_ns, sscanf_ns);
+        return 0;
+    }
+
+} // namespace tsmoreland::interop::benchmarks
@@ -0,0 +1,32 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "benchmark.h"
+
+namespace benchmarks = tsmoreland::interop::benchmarks;
+
+constexpr tsmoreland::benchmarks::benchmark_entry available_benchmarks[] = {
+    {"case_conversion", benchmarks::case_conversion_benchmark},
+    {"dispatch_lookup", benchmarks::dispatch_lookup_benchmark},
+    {"guid_format", benchmarks::guid_format_benchmark},
+    {"guid_parse", benchmarks::guid_parse_benchmark},
+    {"ring_buffer", benchmarks::ring_buffer_benchmark},
+    {"sink_snapshot", benchmarks::sink_snapshot_benchmark},
+};
+
+int main(int argc, char* argv[]) {
+    return tsmoreland::benchmarks::run_benchmark({argv, static_cast<std::size_t>(argc)}, available_benchmarks);
+}
@@ -0,0 +1,189 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "TSMoreland.Interop.Portable/ring_buffer.h"
+#include "TSMoreland.Interop.Portable/shared_memory.h"
+#include "benchmark.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace tsmoreland::interop::benchmarks {
+
+    namespace {
+        /// <summary>
+        /// a queue that copies each message into its own allocation under a lock, as a transport that owns its
+        /// buffers does
+        /// </summary>
+        class locked_queue final {
+        public:
+            explicit locked_queue(std::size_t const capacity) : capacity_{capacity} {}
+
+            bool try_write(std::span<std::byte const> const message) {
+                std::vector<std::byte> copy{message.begin(), message.end()};
+                std::scoped_lock const guard{lock_};
+                if (messages_.size() >= capacity_) {
+                    return false;
+                }
+                messages_.push_back(std::move(copy));
+                return true;
+            }
+
+            template <typename Consume>
+            bool try_read(Consume&& consume) {
+                std::vector<std::byte> message;
+                {
+                    std::scoped_lock const guard{lock_};
+                    if (messages_.empty()) {
+                        return false;
+                    }
+                    message = std::move(messages_.front());
+                    messages_.pop_front();
+                }
+                consume(std::span<std::byte const>{message});
+                return true;
+            }
+
+        private:
+            std::mutex lock_;
+            std::size_t capacity_;
+            std::deque<std::vector<std::byte>> messages_;
+        };
+
+        /// <summary>
+        /// a ring written through one mapping of a shared memory block and read through a second, as the client
+        /// and server of a channel would
+        /// </summary>
+        class shared_ring final {
+        public:
+            shared_ring(std::uint32_t const slot_count, std::uint32_t const slot_size)
+                : writer_memory_{shared_memory::create(name(), ring_buffer::required_size(slot_count, slot_size))}
+                , reader_memory_{shared_memory::open(name())}
+                , writer_{ring_buffer::create(writer_memory_.bytes(), slot_count, slot_size)}
+                , reader_{ring_buffer::attach(reader_memory_.bytes())} {}
+
+            bool try_write(std::span<std::byte const> const message) {
+                return writer_.try_write(message);
+            }
+
+            template <typename Consume>
+            bool try_read(Consume&& consume) {
+                return reader_.try_read(std::forward<Consume>(consume));
+            }
+
+        private:
+            [[nodiscard]]
+            static shared_memory::name_type name() {
+#ifdef _WIN32
+                return L"Local\\tsmoreland-interop-benchmark-" + std::to_wstring(::GetCurrentProcessId());
+#else
+                return "/tsmoreland-interop-benchmark-" + std::to_string(::getpid());
+#endif
+            }
+
+            shared_memory writer_memory_;
+            shared_memory reader_memory_;
+            ring_buffer writer_;
+            ring_buffer reader_;
+        };
+
+        /// <summary>
+        /// sends <paramref name="messages"/> messages of <paramref name="size"/> bytes from
+        /// <paramref name="writers"/> threads to one reader, returning the messages per second
+        /// </summary>
+        template <typename Queue, typename... QueueArguments>
+        double measure(unsigned const writers, std::size_t const messages, std::size_t const size,
+            QueueArguments const... queue_arguments) {
+            std::vector<std::byte> const message(size, std::byte{'a'});
+            std::size_t const per_writer = messages / writers;
+
+            double const elapsed_ns = best_of_ns(3, [&] {
+                Queue queue{queue_arguments...};
+                std::vector<std::thread> writing;
+                for (unsigned w = 0; w < writers; w++) {
+                    writing.emplace_back([&] {
+                        for (std::size_t i = 0; i < per_writer; i++) {
+                            while (!queue.try_write(message)) {
+                                std::this_thread::yield();
+                            }
+                        }
+                    });
+                }
+
+                std::size_t bytes = 0;
+                for (std::size_t received = 0; received < per_writer * writers;) {
+                    bool const read = queue.try_read([&bytes](std::span<std::byte const> const payload) noexcept {
+                        do_not_optimize(payload.front());
+                        bytes += payload.size();
+                    });
+                    if (read) {
+                        received++;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+                for (auto& thread : writing) {
+                    thread.join();
+                }
+                if (bytes != per_writer * writers * size) {
+                    throw std::runtime_error("a message was lost");
+                }
+            });
+            return static_cast<double>(per_writer * writers) / (elapsed_ns / 1e9);
+        }
+    } // namespace
+
+    /// <summary>
+    /// one reader taking messages from 1 writer up to the hardware thread count, through a ring in shared memory
+    /// against a locked queue that allocates a copy of each message
+    /// </summary>
+    /// <param name="args">
+    /// optional message size in bytes, message count and slot count, default 256, 1000000 and 1024
+    /// </param>
+    int ring_buffer_benchmark(arguments const args) {
+        std::size_t const size     = args.size() > 0 ? std::stoull(args[0]) : 256;
+        std::size_t const messages = args.size() > 1 ? std::stoull(args[1]) : 1'000'000;
+        auto const slots           = static_cast<std::uint32_t>(args.size() > 2 ? std::stoul(args[2]) : 1024);
+        auto const slot_size       = static_cast<std::uint32_t>(size);
+        // one thread is left for the reader
+        unsigned const max_writers = std::max(2U, std::thread::hardware_concurrency()) - 1;
+
+        std::printf("message size: %zu, messages: %zu, slots: %u, best of 3 runs\n", size, messages, slots);
+        std::printf("%-8s %16s %16s %12s %9s\n", "writers", "locked msg/s", "ring msg/s", "ring MB/s", "speedup");
+        for (unsigned writers = 1; writers <= max_writers; writers *= 2) {
+            double const locked = measure<locked_queue>(writers, messages, size, std::size_t{slots});
+            double const ring   = measure<shared_ring>(writers, messages, size, slots, slot_size);
+            std::printf("%-8u %16.0f %16.0f %12.1f %8.1fx\n", writers, locked, ring, ring * size / 1e6, ring / locked);
+        }
+        return 0;
+    }
+
+} // namespace tsmoreland::interop::benchmarks
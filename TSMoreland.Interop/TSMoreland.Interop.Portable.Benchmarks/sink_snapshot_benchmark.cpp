@@ -0,0 +1,165 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "TSMoreland.Interop.Portable/sink_snapshot.h"
+#include "benchmark.h"
+
+namespace tsmoreland::interop::benchmarks {
+
+    namespace {
+        /// <summary>
+        /// stands in for an event sink's IDispatch, counting the calls made to it
+        /// </summary>
+        class mock_sink final {
+        public:
+            void invoke(char16_t const* const property_name) noexcept {
+                do_not_optimize(property_name);
+                calls_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            [[nodiscard]]
+            long long calls() const noexcept {
+                return calls_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            std::atomic<long long> calls_{0};
+        };
+
+        /// <summary>
+        /// the previous Fire_OnPropertyChanaged: the object lock is taken and released to read each sink, and the
+        /// property name is copied into a new parameter for each sink as CComVariant does with SysAllocString
+        /// </summary>
+        class locked_sinks final {
+        public:
+            void add(std::shared_ptr<mock_sink> sink) {
+                std::scoped_lock const guard{lock_};
+                sinks_.push_back(std::move(sink));
+            }
+
+            void fire(std::u16string_view const property_name) {
+                for (std::size_t i = 0;; i++) {
+                    std::shared_ptr<mock_sink> sink;
+                    {
+                        std::scoped_lock const guard{lock_};
+                        if (i >= sinks_.size()) {
+                            break;
+                        }
+                        sink = sinks_[i];
+                    }
+
+                    auto const parameter = std::make_unique<char16_t[]>(property_name.size() + 1);
+                    std::ranges::copy(property_name, parameter.get());
+                    sink->invoke(parameter.get());
+                }
+            }
+
+        private:
+            std::mutex lock_;
+            std::vector<std::shared_ptr<mock_sink>> sinks_;
+        };
+
+        /// <summary>
+        /// the snapshot Fire_OnPropertyChanaged: no lock, one parameter shared by every sink
+        /// </summary>
+        class snapshot_sinks final {
+        public:
+            void add(std::shared_ptr<mock_sink> sink) {
+                sinks_.add(next_cookie_++, std::move(sink));
+            }
+
+            void fire(std::u16string_view const property_name) {
+                char16_t const* const parameter = property_name.data();
+                sinks_.for_each([parameter](auto const& sink) { sink->invoke(parameter); });
+            }
+
+        private:
+            sink_snapshot<std::shared_ptr<mock_sink>> sinks_;
+            sink_snapshot<std::shared_ptr<mock_sink>>::cookie_type next_cookie_{1};
+        };
+
+        /// <summary>
+        /// fires from <paramref name="threads"/> threads at once, returning the fires per second across all of them
+        /// </summary>
+        template <typename Sinks>
+        double measure(std::size_t const sink_count, unsigned const threads, int const fires_per_thread) {
+            Sinks sinks;
+            std::vector<std::shared_ptr<mock_sink>> mocks;
+            for (std::size_t i = 0; i < sink_count; i++) {
+                mocks.push_back(std::make_shared<mock_sink>());
+                sinks.add(mocks.back());
+            }
+
+            constexpr std::u16string_view property_name = u"Numeric";
+            double const elapsed_ns = best_of_ns(3, [&] {
+                std::atomic<bool> start{false};
+                std::vector<std::thread> firing;
+                for (unsigned t = 0; t < threads; t++) {
+                    firing.emplace_back([&] {
+                        while (!start.load(std::memory_order_acquire)) {
+                            std::this_thread::yield();
+                        }
+                        for (int i = 0; i < fires_per_thread; i++) {
+                            sinks.fire(property_name);
+                        }
+                    });
+                }
+                start.store(true, std::memory_order_release);
+                for (auto& thread : firing) {
+                    thread.join();
+                }
+            });
+
+            long long const expected = 3LL * threads * fires_per_thread;
+            if (std::ranges::any_of(mocks, [expected](auto const& mock) { return mock->calls() != expected; })) {
+                throw std::runtime_error("a sink missed an event");
+            }
+            return static_cast<double>(threads) * fires_per_thread / (elapsed_ns / 1e9);
+        }
+    } // namespace
+
+    /// <summary>
+    /// Fire_OnPropertyChanaged with a lock per sink and a parameter copy per sink against a lock free snapshot
+    /// and a shared parameter, firing from 1 thread up to the hardware thread count
+    /// </summary>
+    /// <param name="args">optional sink count and fires per thread, default 32 and 20000</param>
+    int sink_snapshot_benchmark(arguments const args) {
+        std::size_t const sink_count = args.size() > 0 ? std::stoull(args[0]) : 32;
+        int const fires              = args.size() > 1 ? std::stoi(args[1]) : 20'000;
+        unsigned const max_threads   = std::max(1U, std::thread::hardware_concurrency());
+
+        std::printf("sinks: %zu, fires per thread: %d, best of 3 runs\n", sink_count, fires);
+        std::printf("%-8s %18s %18s %9s\n", "threads", "locked fires/s", "snapshot fires/s", "speedup");
+        for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+            double const locked   = measure<locked_sinks>(sink_count, threads, fires);
+            double const snapshot = measure<snapshot_sinks>(sink_count, threads, fires);
+            std::printf("%-8u %18.0f %18.0f %8.1fx\n", threads, locked, snapshot, snapshot / locked);
+        }
+        return 0;
+    }
+
+} // namespace tsmoreland::interop::benchmarks
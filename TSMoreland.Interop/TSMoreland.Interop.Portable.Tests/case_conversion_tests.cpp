@@ -0,0 +1,149 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "TSMoreland.Interop.Portable/case_conversion.h"
+#include "test_harness.h"
+
+using tsmoreland::interop::is_supported;
+using tsmoreland::interop::simd_kernel;
+using tsmoreland::interop::to_upper;
+
+namespace {
+    static_assert(to_upper(U'a') == U'A');
+    static_assert(to_upper(U'\u00ff') == U'\u0178');
+    static_assert(to_upper(U'\u00df') == U'\u00df', "has no single code point upper case form");
+    static_assert(to_upper(U'\u01c6') == U'\u01c4');
+    static_assert(to_upper(U'\U0001e922') == U'\U0001e900');
+
+    constexpr simd_kernel all_kernels[] = {simd_kernel::scalar, simd_kernel::sse2, simd_kernel::avx2};
+
+    std::u16string upper_case(std::u16string_view const input, simd_kernel const kernel) {
+        std::u16string output(input.size(), u'\0');
+        to_upper(input, std::span{output}, kernel);
+        return output;
+    }
+
+    /// <summary>
+    /// every length from 0 to 40 so each kernel's blocks and remainders are covered
+    /// </summary>
+    template <typename Check>
+    void for_each_length(std::u16string_view const pattern, Check&& check) {
+        std::u16string input;
+        for (std::size_t length = 0; length <= 40; length++) {
+            check(std::u16string_view{input});
+            input += pattern[length % pattern.size()];
+        }
+    }
+} // namespace
+
+TEST_CASE(converts_ascii_letters_only) {
+    for (simd_kernel const kernel : all_kernels) {
+        if (!is_supported(kernel)) {
+            continue;
+        }
+        CHECK(upper_case(u"the quick brown fox jumps over the lazy dog", kernel) ==
+              u"THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG");
+        CHECK(upper_case(u"`az{ @AZ[ 09 _~\x7f", kernel) == u"`AZ{ @AZ[ 09 _~\x7f");
+    }
+}
+
+TEST_CASE(every_kernel_matches_scalar_for_every_length) {
+    for (simd_kernel const kernel : all_kernels) {
+        if (!is_supported(kernel)) {
+            continue;
+        }
+        for_each_length(u"abcxyz{`@ AZ", [kernel](std::u16string_view const input) {
+            CHECK(upper_case(input, kernel) == upper_case(input, simd_kernel::scalar));
+        });
+        for_each_length(u"abc\u00e9d\u0436xyz\xd83d\xde00", [kernel](std::u16string_view const input) {
+            CHECK(upper_case(input, kernel) == upper_case(input, simd_kernel::scalar));
+        });
+    }
+}
+
+TEST_CASE(table_matches_every_run) {
+    using tsmoreland::interop::details::simple_upper_case_runs;
+
+    std::vector<char32_t> expected(0x20000);
+    for (std::size_t code_point = 0; code_point < expected.size(); code_point++) {
+        expected[code_point] = static_cast<char32_t>(code_point);
+    }
+    for (auto const& run : simple_upper_case_runs) {
+        for (char32_t code_point = run.first; code_point <= run.last; code_point += run.stride) {
+            expected[code_point] = static_cast<char32_t>(static_cast<std::int32_t>(code_point) + run.delta);
+        }
+    }
+    for (std::size_t code_point = 0; code_point < expected.size(); code_point++) {
+        CHECK(to_upper(static_cast<char32_t>(code_point)) == expected[code_point]);
+    }
+    CHECK(to_upper(U'\U0010FFFF') == U'\U0010FFFF');
+}
+
+TEST_CASE(converts_non_ascii_code_units) {
+    for (simd_kernel const kernel : all_kernels) {
+        if (!is_supported(kernel)) {
+            continue;
+        }
+        CHECK(upper_case(u"stra\u00dfe \u00e9t\u00e9 \u0436\u0443\u043a \u03b1\u03b2\u03b3", kernel) ==
+              u"STRA\u00dfE \u00c9T\u00c9 \u0416\u0423\u041a \u0391\u0392\u0393");
+    }
+}
+
+TEST_CASE(converts_surrogate_pairs_across_block_boundaries) {
+    // U+10428 DESERET SMALL LETTER LONG I upper cases to U+10400
+    for (simd_kernel const kernel : all_kernels) {
+        if (!is_supported(kernel)) {
+            continue;
+        }
+        for (std::size_t padding = 0; padding <= 20; padding++) {
+            std::u16string const prefix(padding, u'a');
+            std::u16string const expected = std::u16string(padding, u'A') + u"\xd801\xdc00Z";
+            CHECK(upper_case(prefix + u"\xd801\xdc28z", kernel) == expected);
+        }
+    }
+}
+
+TEST_CASE(copies_unpaired_surrogates_unchanged) {
+    for (simd_kernel const kernel : all_kernels) {
+        if (!is_supported(kernel)) {
+            continue;
+        }
+        CHECK(upper_case(u"\xdc28" u"a\xd801" u"a\xd801", kernel) == u"\xdc28" u"A\xd801" u"A\xd801");
+    }
+}
+
+TEST_CASE(converts_in_place) {
+    std::u16string text = u"in place conversion of a string longer than one block \xd801\xdc28";
+    to_upper(std::u16string_view{text}, std::span{text});
+    CHECK(text == u"IN PLACE CONVERSION OF A STRING LONGER THAN ONE BLOCK \xd801\xdc00");
+}
+
+TEST_CASE(leaves_output_past_input_untouched) {
+    std::vector<char16_t> output(20, u'#');
+    to_upper(std::u16string_view{u"abc"}, std::span{output});
+    CHECK(std::u16string_view(output.data(), output.size()) == u"ABC#################");
+}
+
+TEST_CASE(to_upper_throws_when_output_too_small) {
+    std::u16string output(2, u'\0');
+    CHECK_THROWS(to_upper(std::u16string_view{u"abc"}, std::span{output}), std::invalid_argument);
+}
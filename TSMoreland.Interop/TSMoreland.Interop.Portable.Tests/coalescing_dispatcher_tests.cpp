@@ -0,0 +1,242 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <array>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TSMoreland.Interop.Portable/coalescing_dispatcher.h"
+#include "test_harness.h"
+
+using tsmoreland::interop::coalescing_dispatcher;
+using tsmoreland::interop::post_result;
+
+namespace {
+    /// <summary>
+    /// holds the dispatcher thread in its first delivery until opened, so later posts stay queued
+    /// </summary>
+    class gate final {
+    public:
+        void wait_until_entered() {
+            entered_.get_future().wait();
+        }
+
+        void enter_and_wait() {
+            std::call_once(entered_once_, [this] { entered_.set_value(); });
+            opened_future_.wait();
+        }
+
+        void open() {
+            opened_.set_value();
+        }
+
+    private:
+        std::promise<void> entered_;
+        std::once_flag entered_once_;
+        std::promise<void> opened_;
+        std::shared_future<void> opened_future_{opened_.get_future().share()};
+    };
+
+    struct recorded {
+        std::mutex lock;
+        std::vector<std::string> keys;
+
+        void add(std::string const& key) {
+            std::scoped_lock const guard{lock};
+            keys.push_back(key);
+        }
+    };
+} // namespace
+
+TEST_CASE(dispatcher_delivers_each_posted_key) {
+    recorded delivered;
+    coalescing_dispatcher<std::string> dispatcher{8, [&](std::string const& key) { delivered.add(key); }};
+
+    CHECK(dispatcher.post("Numeric") == post_result::queued);
+    dispatcher.flush();
+    CHECK(dispatcher.post("Name") == post_result::queued);
+    dispatcher.flush();
+
+    CHECK((delivered.keys == std::vector<std::string>{"Numeric", "Name"}));
+    auto const statistics = dispatcher.statistics();
+    CHECK(statistics.posted == 2 && statistics.delivered == 2);
+    CHECK(statistics.queue_depth == 0);
+}
+
+TEST_CASE(dispatcher_coalesces_keys_waiting_for_delivery) {
+    gate blocked;
+    recorded delivered;
+    coalescing_dispatcher<std::string> dispatcher{8, [&](std::string const& key) {
+        blocked.enter_and_wait();
+        delivered.add(key);
+    }};
+
+    CHECK(dispatcher.post("first") == post_result::queued);
+    blocked.wait_until_entered();
+    CHECK(dispatcher.post("Numeric") == post_result::queued);
+    CHECK(dispatcher.post("Numeric") == post_result::coalesced);
+    CHECK(dispatcher.post("Name") == post_result::queued);
+    CHECK(dispatcher.post("Numeric") == post_result::coalesced);
+    CHECK(dispatcher.statistics().queue_depth == 2);
+    blocked.open();
+    dispatcher.flush();
+
+    CHECK((delivered.keys == std::vector<std::string>{"first", "Numeric", "Name"}));
+    auto const statistics = dispatcher.statistics();
+    CHECK(statistics.posted == 5 && statistics.delivered == 3 && statistics.coalesced == 2);
+}
+
+TEST_CASE(dispatcher_redelivers_key_changed_during_its_delivery) {
+    gate blocked;
+    recorded delivered;
+    coalescing_dispatcher<std::string> dispatcher{8, [&](std::string const& key) {
+        blocked.enter_and_wait();
+        delivered.add(key);
+    }};
+
+    CHECK(dispatcher.post("Numeric") == post_result::queued);
+    blocked.wait_until_entered();
+    CHECK(dispatcher.post("Numeric") == post_result::queued);
+    blocked.open();
+    dispatcher.flush();
+
+    CHECK(delivered.keys.size() == 2);
+}
+
+TEST_CASE(dispatcher_drops_posts_to_a_full_queue) {
+    gate blocked;
+    coalescing_dispatcher<int> dispatcher{2, [&](int) { blocked.enter_and_wait(); }};
+
+    CHECK(dispatcher.post(0) == post_result::queued);
+    blocked.wait_until_entered();
+    CHECK(dispatcher.post(1) == post_result::queued);
+    CHECK(dispatcher.post(2) == post_result::queued);
+    CHECK(dispatcher.post(3) == post_result::dropped);
+    CHECK(dispatcher.post(1) == post_result::coalesced);
+    blocked.open();
+    dispatcher.flush();
+
+    auto const statistics = dispatcher.statistics();
+    CHECK(statistics.delivered == 3 && statistics.dropped == 1 && statistics.coalesced == 1);
+}
+
+TEST_CASE(dispatcher_delivers_queued_keys_on_stop_and_drops_later_posts) {
+    gate blocked;
+    std::atomic<int> delivered{0};
+    coalescing_dispatcher<int> dispatcher{8, [&](int) {
+        blocked.enter_and_wait();
+        delivered++;
+    }};
+
+    dispatcher.post(0);
+    blocked.wait_until_entered();
+    dispatcher.post(1);
+    dispatcher.post(2);
+    std::thread opener{[&] { blocked.open(); }};
+    dispatcher.stop();
+    opener.join();
+
+    CHECK(delivered == 3);
+    CHECK(dispatcher.post(3) == post_result::dropped);
+}
+
+TEST_CASE(dispatcher_can_be_stopped_from_its_handler) {
+    std::unique_ptr<coalescing_dispatcher<int>> dispatcher;
+    std::promise<void> stopped;
+    dispatcher = std::make_unique<coalescing_dispatcher<int>>(8, [&](int) {
+        dispatcher->stop();
+        dispatcher.reset();
+        stopped.set_value();
+    });
+
+    dispatcher->post(0);
+    CHECK(stopped.get_future().wait_for(std::chrono::seconds{10}) == std::future_status::ready);
+}
+
+TEST_CASE(dispatcher_rejects_invalid_arguments) {
+    CHECK_THROWS((coalescing_dispatcher<int>{0, [](int) {}}), std::invalid_argument);
+    CHECK_THROWS((coalescing_dispatcher<int>{8, nullptr}), std::invalid_argument);
+}
+
+namespace {
+    thread_local bool inside_scope = false;
+
+    struct flag_scope {
+        flag_scope() noexcept {
+            inside_scope = true;
+        }
+        ~flag_scope() {
+            inside_scope = false;
+        }
+    };
+} // namespace
+
+TEST_CASE(dispatcher_delivers_inside_thread_scope) {
+    std::atomic<bool> delivered_inside{false};
+    coalescing_dispatcher<int, flag_scope> dispatcher{8, [&](int) { delivered_inside = inside_scope; }};
+
+    dispatcher.post(0);
+    dispatcher.flush();
+
+    CHECK(delivered_inside);
+    CHECK(!inside_scope);
+}
+
+TEST_CASE(dispatcher_stress_delivers_last_change_to_every_key) {
+    constexpr int key_count = 16;
+    constexpr int writers   = 4;
+    constexpr int writes    = 50'000;
+
+    // each key's latest value, and the value the handler saw when it last delivered that key
+    std::array<std::atomic<int>, key_count> values{};
+    std::array<std::atomic<int>, key_count> observed{};
+
+    coalescing_dispatcher<int> dispatcher{key_count, [&](int const key) {
+        observed[key].store(values[key].load(std::memory_order_acquire), std::memory_order_relaxed);
+    }};
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; w++) {
+        threads.emplace_back([&, w] {
+            for (int i = 1; i <= writes; i++) {
+                int const key = (i * 7 + w) % key_count;
+                values[key].fetch_add(1, std::memory_order_release);
+                dispatcher.post(key);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    dispatcher.stop();
+
+    auto const statistics = dispatcher.statistics();
+    CHECK(statistics.posted == static_cast<std::uint64_t>(writers) * writes);
+    CHECK(statistics.dropped == 0);
+    CHECK(statistics.delivered + statistics.coalesced == statistics.posted);
+    CHECK(statistics.queue_depth == 0);
+    for (int key = 0; key < key_count; key++) {
+        CHECK(observed[key] == values[key]);
+    }
+}
@@ -0,0 +1,90 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+#include <array>
+#include <stdexcept>
+
+#include "TSMoreland.Interop.Portable/dispatch_table.h"
+#include "test_harness.h"
+
+using tsmoreland::interop::dispatch_name;
+using tsmoreland::interop::perfect_hash_map;
+
+namespace {
+    constexpr std::array<dispatch_name, 5> names{{
+        {L"Name", 1},
+        {L"Numeric", 2},
+        {L"Description", 5},
+        {L"ToUpper", 6},
+        {L"AddNumeric", 11},
+    }};
+
+    constexpr perfect_hash_map map{names};
+
+    static_assert(map.find(L"Numeric") == 2);
+    static_assert(map.find(L"toupper") == 6);
+    static_assert(!map.find(L"Missing").has_value());
+} // namespace
+
+TEST_CASE(perfect_hash_map_finds_every_name) {
+    for (auto const& [name, id] : names) {
+        CHECK(map.find(name) == id);
+    }
+}
+
+TEST_CASE(perfect_hash_map_ignores_case) {
+    CHECK(map.find(L"NAME") == 1);
+    CHECK(map.find(L"description") == 5);
+    CHECK(map.find(L"aDDnUMERIC") == 11);
+}
+
+TEST_CASE(perfect_hash_map_rejects_names_it_does_not_hold) {
+    CHECK(!map.find(L"").has_value());
+    CHECK(!map.find(L"Nam").has_value());
+    CHECK(!map.find(L"Names").has_value());
+    CHECK(!map.find(L"ToUpperMany").has_value());
+}
+
+TEST_CASE(perfect_hash_map_rejects_duplicate_names) {
+    std::array<dispatch_name, 2> const duplicates{{{L"Name", 1}, {L"NAME", 2}}};
+
+    CHECK_THROWS(perfect_hash_map{duplicates}, std::invalid_argument);
+}
+
+TEST_CASE(perfect_hash_map_is_built_for_many_names) {
+    constexpr std::array<dispatch_name, 16> many{{
+        {L"Name", 1},
+        {L"Id", 2},
+        {L"Numeric", 3},
+        {L"Description", 4},
+        {L"ToUpper", 5},
+        {L"ToUpperMany", 6},
+        {L"AsyncEvents", 7},
+        {L"GetEventStatistics", 8},
+        {L"AddNumeric", 9},
+        {L"CompareExchangeNumeric", 10},
+        {L"GetStringStatistics", 11},
+        {L"GetActivationStatistics", 12},
+        {L"OpenChannel", 13},
+        {L"ProcessChannel", 14},
+        {L"GetImmutableProperties", 15},
+        {L"GetState", 16},
+    }};
+    constexpr perfect_hash_map many_map{many};
+
+    for (auto const& [name, id] : many) {
+        CHECK(many_map.find(name) == id);
+    }
+}
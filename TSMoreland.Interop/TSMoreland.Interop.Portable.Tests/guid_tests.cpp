@@ -0,0 +1,134 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <array>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+#include "TSMoreland.Interop.Portable/guid.h"
+#include "test_harness.h"
+
+using tsmoreland::interop::format_guid;
+using tsmoreland::interop::guid;
+using tsmoreland::interop::guid_string_length;
+using tsmoreland::interop::parse_guid;
+using tsmoreland::interop::try_parse_guid;
+using namespace tsmoreland::interop::literals;
+
+namespace {
+    constexpr guid expected{0xE3FF39CC, 0xD456, 0x4A43, {0xA7, 0x99, 0x8B, 0x19, 0xA6, 0x13, 0x99, 0x08}};
+
+    // evaluated by the compiler, a regression fails the build rather than the test run
+    static_assert("E3FF39CC-D456-4A43-A799-8B19A6139908"_guid == expected);
+    static_assert(parse_guid("{e3ff39cc-d456-4a43-a799-8b19a6139908}") == expected);
+    static_assert(!try_parse_guid("E3FF39CC-D456-4A43-A799-8B19A613990G").has_value());
+
+    template <typename CharT>
+    constexpr std::array<CharT, guid_string_length> format(guid const& value) {
+        std::array<CharT, guid_string_length> text{};
+        format_guid(value, std::span{text});
+        return text;
+    }
+
+    template <typename CharT>
+    constexpr std::basic_string_view<CharT> view(std::array<CharT, guid_string_length> const& text) {
+        return {text.data(), text.size()};
+    }
+
+    static_assert(view(format<char>(expected)) == "e3ff39cc-d456-4a43-a799-8b19a6139908");
+} // namespace
+
+TEST_CASE(parses_upper_and_lower_case) {
+    CHECK(try_parse_guid("E3FF39CC-D456-4A43-A799-8B19A6139908") == expected);
+    CHECK(try_parse_guid("e3ff39cc-d456-4a43-a799-8b19a6139908") == expected);
+    CHECK(try_parse_guid("e3Ff39cC-D456-4a43-A799-8b19A6139908") == expected);
+}
+
+TEST_CASE(parses_braced) {
+    CHECK(try_parse_guid("{E3FF39CC-D456-4A43-A799-8B19A6139908}") == expected);
+}
+
+TEST_CASE(parses_wide) {
+    CHECK(try_parse_guid(L"E3FF39CC-D456-4A43-A799-8B19A6139908") == expected);
+    CHECK(try_parse_guid(L"{e3ff39cc-d456-4a43-a799-8b19a6139908}") == expected);
+}
+
+TEST_CASE(parses_extremes) {
+    CHECK(try_parse_guid("00000000-0000-0000-0000-000000000000") == guid{});
+    CHECK(try_parse_guid("ffffffff-ffff-ffff-ffff-ffffffffffff") ==
+          (guid{0xFFFFFFFF, 0xFFFF, 0xFFFF, {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}}));
+}
+
+TEST_CASE(rejects_wrong_length) {
+    CHECK(!try_parse_guid("").has_value());
+    CHECK(!try_parse_guid("E3FF39CC-D456-4A43-A799-8B19A613990").has_value());
+    CHECK(!try_parse_guid("E3FF39CC-D456-4A43-A799-8B19A61399080").has_value());
+    CHECK(!try_parse_guid("E3FF39CCD4564A43A7998B19A6139908").has_value());
+}
+
+TEST_CASE(rejects_misplaced_separators) {
+    CHECK(!try_parse_guid("E3FF39C-CD456-4A43-A799-8B19A6139908").has_value());
+    CHECK(!try_parse_guid("E3FF39CC-D456-4A43-A7998-B19A6139908").has_value());
+    CHECK(!try_parse_guid("E3FF39CC_D456_4A43_A799_8B19A6139908").has_value());
+}
+
+TEST_CASE(rejects_unbalanced_braces) {
+    CHECK(!try_parse_guid("{E3FF39CC-D456-4A43-A799-8B19A6139908").has_value());
+    CHECK(!try_parse_guid("(E3FF39CC-D456-4A43-A799-8B19A6139908)").has_value());
+    CHECK(!try_parse_guid("{E3FF39CC-D456-4A43-A799-8B19A6139908 ").has_value());
+}
+
+TEST_CASE(rejects_non_hex_digits) {
+    CHECK(!try_parse_guid("X3FF39CC-D456-4A43-A799-8B19A6139908").has_value());
+    CHECK(!try_parse_guid("E3FF39CC-D456-4A43-A799-8B19A613990 ").has_value());
+    CHECK(!try_parse_guid("E3FF39CC-D456-4A43-A799-8B19A613990\xC3").has_value());
+}
+
+TEST_CASE(rejects_wide_characters_outside_ascii) {
+    // U+0130 and U+0141 share their low byte with '0' and 'A' and must not be read as them
+    CHECK(!try_parse_guid(L"E3FF39CC-D456-4A43-A799-8B19A613990\u0130").has_value());
+    CHECK(!try_parse_guid(L"\u0141\u0141FF39CC-D456-4A43-A799-8B19A6139908").has_value());
+}
+
+TEST_CASE(parse_guid_throws_when_invalid) {
+    CHECK(parse_guid("E3FF39CC-D456-4A43-A799-8B19A6139908") == expected);
+    CHECK_THROWS(parse_guid("not a guid"), std::invalid_argument);
+    CHECK_THROWS(parse_guid(L"not a guid"), std::invalid_argument);
+}
+
+TEST_CASE(formats_lower_case_registry_format) {
+    CHECK(view(format<char>(expected)) == "e3ff39cc-d456-4a43-a799-8b19a6139908");
+    CHECK(view(format<wchar_t>(expected)) == L"e3ff39cc-d456-4a43-a799-8b19a6139908");
+    CHECK(view(format<char16_t>(expected)) == u"e3ff39cc-d456-4a43-a799-8b19a6139908");
+    CHECK(view(format<char>(guid{})) == "00000000-0000-0000-0000-000000000000");
+}
+
+TEST_CASE(format_round_trips_through_parse) {
+    std::mt19937_64 engine{42};
+    for (int i = 0; i < 10'000; i++) {
+        auto const high = engine();
+        auto const low  = engine();
+        guid value{static_cast<std::uint32_t>(high >> 32), static_cast<std::uint16_t>(high >> 16),
+            static_cast<std::uint16_t>(high), {}};
+        for (std::size_t byte = 0; byte < value.data4.size(); byte++) {
+            value.data4[byte] = static_cast<std::uint8_t>(low >> (byte * 8));
+        }
+        CHECK(try_parse_guid(view(format<char>(value))) == value);
+        CHECK(try_parse_guid(view(format<wchar_t>(value))) == value);
+    }
+}
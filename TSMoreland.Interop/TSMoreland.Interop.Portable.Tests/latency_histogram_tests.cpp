@@ -0,0 +1,91 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "TSMoreland.Interop.Portable/latency_histogram.h"
+#include "test_harness.h"
+
+using namespace std::chrono_literals;
+using tsmoreland::interop::latency_histogram;
+
+namespace {
+    static_assert(latency_histogram::bucket_of(0) == 0);
+    static_assert(latency_histogram::bucket_of(1) == 1);
+    static_assert(latency_histogram::bucket_of(1023) == 10);
+    static_assert(latency_histogram::bucket_of(1024) == 11);
+    static_assert(latency_histogram::bucket_of(std::numeric_limits<std::uint64_t>::max()) ==
+                  latency_histogram::bucket_count - 1);
+    static_assert(latency_histogram::bucket_upper_bound(10) == 1023);
+} // namespace
+
+TEST_CASE(empty_histogram_summary_is_zero) {
+    latency_histogram const histogram;
+    auto const summary = histogram.summary();
+
+    CHECK(summary.count == 0 && summary.mean_ns == 0.0 && summary.max_ns == 0);
+}
+
+TEST_CASE(histogram_reports_mean_max_and_bucketed_percentiles) {
+    latency_histogram histogram;
+    for (int i = 0; i < 98; i++) {
+        histogram.record(100ns);
+    }
+    histogram.record(5us);
+    histogram.record(1ms);
+
+    auto const summary = histogram.summary();
+    CHECK(summary.count == 100);
+    CHECK(summary.mean_ns == (98 * 100 + 5'000 + 1'000'000) / 100.0);
+    CHECK(summary.p50_ns == 127);
+    CHECK(summary.p99_ns == 8'191);
+    CHECK(summary.max_ns == 1'000'000);
+}
+
+TEST_CASE(histogram_records_negative_durations_as_zero) {
+    latency_histogram histogram;
+    histogram.record(-5ns);
+
+    auto const summary = histogram.summary();
+    CHECK(summary.count == 1 && summary.max_ns == 0 && summary.p99_ns == 0);
+}
+
+TEST_CASE(histogram_counts_every_record_from_many_threads) {
+    constexpr int threads = 4;
+    constexpr int records = 50'000;
+
+    latency_histogram histogram;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&histogram, t] {
+            for (int i = 0; i < records; i++) {
+                histogram.record(std::chrono::nanoseconds{(t + 1) * 1'000});
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    auto const summary = histogram.summary();
+    CHECK(summary.count == static_cast<std::uint64_t>(threads) * records);
+    CHECK(summary.max_ns == threads * 1'000);
+    CHECK(summary.mean_ns == 2'500.0);
+}
@@ -0,0 +1,38 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <exception>
+#include <iostream>
+
+#include "test_harness.h"
+
+int main() {
+    using tsmoreland::interop::tests::registered_tests;
+
+    int failed = 0;
+    for (auto const& [name, run] : registered_tests()) {
+        try {
+            run();
+            std::cout << "[pass] " << name << "\n";
+        } catch (std::exception const& ex) {
+            failed++;
+            std::cout << "[fail] " << name << ": " << ex.what() << "\n";
+        }
+    }
+
+    std::cout << registered_tests().size() - static_cast<std::size_t>(failed) << " passed, " << failed << " failed\n";
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "TSMoreland.Interop.Portable/object_pool.h"
+#include "test_harness.h"
+
+using tsmoreland::interop::object_pool;
+
+namespace {
+    struct pooled {
+        int value{0};
+    };
+} // namespace
+
+TEST_CASE(pool_misses_when_empty_and_hits_returned_objects) {
+    object_pool<pooled> pool{2};
+    pooled object;
+
+    CHECK(pool.try_acquire() == nullptr);
+    CHECK(pool.try_return(&object));
+    CHECK(pool.try_acquire() == &object);
+    CHECK(pool.try_acquire() == nullptr);
+
+    auto const statistics = pool.statistics();
+    CHECK(statistics.hits == 1 && statistics.misses == 2 && statistics.returned == 1);
+    CHECK(statistics.idle == 0 && statistics.capacity == 2);
+}
+
+TEST_CASE(pool_hands_out_most_recently_returned_first) {
+    object_pool<pooled> pool{2};
+    pooled first;
+    pooled second;
+
+    CHECK(pool.try_return(&first));
+    CHECK(pool.try_return(&second));
+
+    CHECK(pool.try_acquire() == &second);
+    CHECK(pool.try_acquire() == &first);
+}
+
+TEST_CASE(pool_discards_objects_beyond_capacity) {
+    object_pool<pooled> pool{1};
+    pooled first;
+    pooled second;
+
+    CHECK(pool.try_return(&first));
+    CHECK(!pool.try_return(&second));
+    CHECK(pool.statistics().discarded == 1);
+
+    object_pool<pooled> disabled;
+    CHECK(!disabled.try_return(&first));
+}
+
+TEST_CASE(pool_shrinking_returns_excess_objects) {
+    object_pool<pooled> pool{3};
+    pooled objects[3];
+    for (auto& object : objects) {
+        CHECK(pool.try_return(&object));
+    }
+
+    auto const excess = pool.set_capacity(1);
+
+    CHECK(excess.size() == 2);
+    CHECK(pool.statistics().idle == 1);
+    CHECK(pool.try_acquire() == &objects[0]);
+}
+
+TEST_CASE(pool_drain_returns_idle_objects_and_disables_pooling) {
+    object_pool<pooled> pool{2};
+    pooled first;
+    pooled second;
+    CHECK(pool.try_return(&first));
+    CHECK(pool.try_return(&second));
+
+    auto const drained = pool.drain();
+
+    CHECK(drained.size() == 2);
+    CHECK(pool.try_acquire() == nullptr);
+    CHECK(!pool.try_return(&first));
+    CHECK(pool.statistics().capacity == 0);
+}
+
+TEST_CASE(pool_never_hands_one_object_to_two_threads) {
+    constexpr int threads    = 4;
+    constexpr int iterations = 20'000;
+    constexpr int objects    = 3;
+
+    object_pool<pooled> pool{objects};
+    std::vector<std::unique_ptr<pooled>> owned;
+    for (int i = 0; i < objects; i++) {
+        owned.push_back(std::make_unique<pooled>());
+        CHECK(pool.try_return(owned.back().get()));
+    }
+
+    std::atomic<bool> shared{false};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < iterations; i++) {
+                pooled* const object = pool.try_acquire();
+                if (object == nullptr) {
+                    continue;
+                }
+                // non-atomic on purpose, an object in use by two threads at once shows up as a lost increment
+                object->value++;
+                if (object->value != 1) {
+                    shared = true;
+                }
+                object->value--;
+                static_cast<void>(pool.try_return(object));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    CHECK(!shared);
+    auto const statistics = pool.statistics();
+    CHECK(statistics.idle == objects);
+    CHECK(statistics.hits + statistics.misses == static_cast<std::uint64_t>(threads) * iterations);
+    CHECK(statistics.returned == objects + statistics.hits);
+}
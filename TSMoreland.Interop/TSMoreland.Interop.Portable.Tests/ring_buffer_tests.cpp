@@ -0,0 +1,198 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "TSMoreland.Interop.Portable/ring_buffer.h"
+#include "TSMoreland.Interop.Portable/shared_memory.h"
+#include "test_harness.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+using tsmoreland::interop::ring_buffer;
+using tsmoreland::interop::ring_channel;
+using tsmoreland::interop::shared_memory;
+
+namespace {
+    /// <summary>
+    /// zeroed memory aligned as a mapping would be
+    /// </summary>
+    struct aligned_memory {
+        explicit aligned_memory(std::size_t const size)
+            : storage{std::make_unique<std::byte[]>(size + 64)}
+            , bytes{storage.get() + (64 - reinterpret_cast<std::uintptr_t>(storage.get()) % 64) % 64, size} {}
+
+        std::unique_ptr<std::byte[]> storage;
+        std::span<std::byte> bytes;
+    };
+
+    bool write_value(ring_buffer& ring, std::uint64_t const value) {
+        return ring.try_write(std::as_bytes(std::span{&value, 1}));
+    }
+
+    bool read_value(ring_buffer& ring, std::uint64_t& value) {
+        return ring.try_read([&value](std::span<std::byte const> const message) noexcept {
+            std::memcpy(&value, message.data(), std::min(message.size(), sizeof(value)));
+        });
+    }
+
+    [[nodiscard]]
+    shared_memory::name_type unique_name(char const* const test) {
+#ifdef _WIN32
+        std::string const narrow = std::string{"Local\\tsmoreland-interop-"} + test + "-" +
+            std::to_string(::GetCurrentProcessId());
+        return {narrow.begin(), narrow.end()};
+#else
+        return std::string{"/tsmoreland-interop-"} + test + "-" + std::to_string(::getpid());
+#endif
+    }
+} // namespace
+
+TEST_CASE(ring_rejects_invalid_layouts) {
+    aligned_memory memory{ring_buffer::required_size(4, 16)};
+
+    CHECK_THROWS(ring_buffer::create(memory.bytes, 3, 16), std::invalid_argument);
+    CHECK_THROWS(ring_buffer::create(memory.bytes, 1, 16), std::invalid_argument);
+    CHECK_THROWS(ring_buffer::create(memory.bytes, 4, 0), std::invalid_argument);
+    CHECK_THROWS(ring_buffer::create(memory.bytes, 8, 16), std::invalid_argument);
+    CHECK_THROWS(ring_buffer::create(memory.bytes.subspan(8), 4, 16), std::invalid_argument);
+    CHECK_THROWS(ring_buffer::attach(memory.bytes), std::invalid_argument);
+}
+
+TEST_CASE(ring_reads_messages_in_the_order_written_until_empty) {
+    aligned_memory memory{ring_buffer::required_size(4, 16)};
+    auto ring = ring_buffer::create(memory.bytes, 4, 16);
+    CHECK(ring.empty() && !ring.full());
+
+    for (std::uint64_t i = 0; i < 4; i++) {
+        CHECK(write_value(ring, i));
+    }
+    CHECK(ring.full());
+    CHECK(!write_value(ring, 4));
+
+    for (std::uint64_t i = 0; i < 4; i++) {
+        std::uint64_t value{};
+        CHECK(read_value(ring, value));
+        CHECK(value == i);
+    }
+    std::uint64_t value{};
+    CHECK(ring.empty());
+    CHECK(!read_value(ring, value));
+}
+
+TEST_CASE(ring_reuses_slots_across_laps) {
+    aligned_memory memory{ring_buffer::required_size(2, 8)};
+    auto ring = ring_buffer::create(memory.bytes, 2, 8);
+
+    for (std::uint64_t i = 0; i < 100; i++) {
+        CHECK(write_value(ring, i));
+        std::uint64_t value{};
+        CHECK(read_value(ring, value));
+        CHECK(value == i);
+    }
+}
+
+TEST_CASE(ring_rejects_messages_larger_than_a_slot) {
+    aligned_memory memory{ring_buffer::required_size(2, 4)};
+    auto ring = ring_buffer::create(memory.bytes, 2, 4);
+    std::array<std::byte, 5> const message{};
+
+    CHECK_THROWS(ring.try_write(message), std::invalid_argument);
+    CHECK(ring.empty());
+}
+
+TEST_CASE(channel_attached_through_a_second_mapping_shares_the_rings) {
+    auto const name = unique_name("channel");
+    auto server     = shared_memory::create(name, ring_channel::required_size(4, 32));
+    auto client     = shared_memory::open(name);
+    CHECK(client.bytes().data() != server.bytes().data());
+    CHECK(client.bytes().size() >= server.bytes().size());
+
+    auto server_channel = ring_channel::create(server.bytes(), 4, 32);
+    auto client_channel = ring_channel::attach(client.bytes());
+    CHECK(client_channel.requests.slot_count() == 4 && client_channel.requests.slot_size() == 32);
+
+    CHECK(write_value(client_channel.requests, 42));
+    std::uint64_t request{};
+    CHECK(read_value(server_channel.requests, request));
+    CHECK(request == 42);
+
+    CHECK(write_value(server_channel.responses, request + 1));
+    std::uint64_t response{};
+    CHECK(read_value(client_channel.responses, response));
+    CHECK(response == 43);
+}
+
+TEST_CASE(shared_memory_names_are_exclusive_and_removed_by_the_creator) {
+    auto const name = unique_name("exclusive");
+    {
+        auto const memory = shared_memory::create(name, 4096);
+        CHECK_THROWS(shared_memory::create(name, 4096), std::system_error);
+    }
+    CHECK_THROWS(shared_memory::open(name), std::system_error);
+}
+
+TEST_CASE(ring_delivers_every_message_from_many_writers_in_order_per_writer) {
+    constexpr unsigned writers         = 4;
+    constexpr std::uint64_t per_writer = 20'000;
+    auto const name                    = unique_name("writers");
+    auto const memory                  = shared_memory::create(name, ring_buffer::required_size(64, 8));
+    auto const reader_memory           = shared_memory::open(name);
+    auto ring                          = ring_buffer::create(memory.bytes(), 64, 8);
+    auto reader                        = ring_buffer::attach(reader_memory.bytes());
+
+    std::vector<std::thread> threads;
+    for (std::uint64_t writer = 0; writer < writers; writer++) {
+        threads.emplace_back([&ring, writer] {
+            for (std::uint64_t i = 0; i < per_writer; i++) {
+                while (!write_value(ring, writer << 32 | i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::array<std::uint64_t, writers> next{};
+    bool ordered = true;
+    for (std::uint64_t received = 0; received < writers * per_writer;) {
+        std::uint64_t value{};
+        if (!read_value(reader, value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        auto const writer = static_cast<std::size_t>(value >> 32);
+        ordered           = ordered && writer < writers && (value & 0xFFFF'FFFF) == next[writer];
+        next[writer % writers]++;
+        received++;
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(ordered);
+    CHECK(reader.empty());
+}
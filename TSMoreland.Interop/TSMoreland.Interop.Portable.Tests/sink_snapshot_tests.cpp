@@ -0,0 +1,148 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "TSMoreland.Interop.Portable/sink_snapshot.h"
+#include "test_harness.h"
+
+using tsmoreland::interop::sink_snapshot;
+
+namespace {
+    struct counting_sink {
+        std::atomic<int> calls{0};
+
+        void invoke() noexcept {
+            calls.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+} // namespace
+
+TEST_CASE(fires_each_added_sink_once) {
+    sink_snapshot<std::shared_ptr<counting_sink>> sinks;
+    auto const first  = std::make_shared<counting_sink>();
+    auto const second = std::make_shared<counting_sink>();
+    sinks.add(1, first);
+    sinks.add(2, second);
+
+    sinks.for_each([](auto const& sink) { sink->invoke(); });
+
+    CHECK(first->calls == 1);
+    CHECK(second->calls == 1);
+}
+
+TEST_CASE(removed_sink_is_not_fired) {
+    sink_snapshot<std::shared_ptr<counting_sink>> sinks;
+    auto const first  = std::make_shared<counting_sink>();
+    auto const second = std::make_shared<counting_sink>();
+    sinks.add(1, first);
+    sinks.add(2, second);
+
+    CHECK(sinks.remove(1));
+    CHECK(!sinks.remove(1));
+    CHECK(!sinks.remove(3));
+    sinks.for_each([](auto const& sink) { sink->invoke(); });
+
+    CHECK(first->calls == 0);
+    CHECK(second->calls == 1);
+    CHECK(sinks.snapshot()->size() == 1);
+}
+
+TEST_CASE(clear_removes_every_sink) {
+    sink_snapshot<int> sinks;
+    sinks.add(1, 10);
+    sinks.add(2, 20);
+    auto const before = sinks.snapshot();
+
+    sinks.clear();
+
+    CHECK(sinks.snapshot()->empty());
+    CHECK(before->size() == 2);
+    CHECK(!sinks.remove(1));
+    sinks.add(1, 10);
+    CHECK(sinks.snapshot()->size() == 1);
+}
+
+TEST_CASE(snapshot_is_unchanged_by_later_advise_and_unadvise) {
+    sink_snapshot<int> sinks;
+    sinks.add(1, 10);
+    auto const before = sinks.snapshot();
+
+    sinks.add(2, 20);
+    CHECK(sinks.remove(1));
+
+    CHECK(before->size() == 1);
+    CHECK((*before)[0].cookie == 1 && (*before)[0].sink == 10);
+    auto const after = sinks.snapshot();
+    CHECK(after->size() == 1);
+    CHECK((*after)[0].cookie == 2 && (*after)[0].sink == 20);
+}
+
+TEST_CASE(removed_sink_outlives_snapshots_still_firing_it) {
+    sink_snapshot<std::shared_ptr<counting_sink>> sinks;
+    std::weak_ptr<counting_sink> removed;
+    {
+        auto const sink = std::make_shared<counting_sink>();
+        removed         = sink;
+        sinks.add(1, sink);
+    }
+    auto const firing = sinks.snapshot();
+
+    CHECK(sinks.remove(1));
+    CHECK(!removed.expired());
+    (*firing)[0].sink->invoke();
+    CHECK(removed.lock()->calls == 1);
+}
+
+TEST_CASE(fires_concurrently_with_advise_and_unadvise) {
+    constexpr int firing_threads = 4;
+    constexpr int fires          = 20'000;
+
+    sink_snapshot<std::shared_ptr<counting_sink>> sinks;
+    auto const permanent = std::make_shared<counting_sink>();
+    sinks.add(0, permanent);
+
+    std::atomic<bool> done{false};
+    std::thread writer{[&] {
+        std::uint32_t cookie = 1;
+        while (!done.load(std::memory_order_relaxed)) {
+            sinks.add(cookie, std::make_shared<counting_sink>());
+            sinks.remove(cookie);
+            cookie++;
+        }
+    }};
+
+    std::vector<std::thread> firing;
+    for (int t = 0; t < firing_threads; t++) {
+        firing.emplace_back([&] {
+            for (int i = 0; i < fires; i++) {
+                sinks.for_each([](auto const& sink) { sink->invoke(); });
+            }
+        });
+    }
+    for (auto& thread : firing) {
+        thread.join();
+    }
+    done = true;
+    writer.join();
+
+    CHECK(permanent->calls == firing_threads * fires);
+    CHECK(sinks.snapshot()->size() == 1);
+}
@@ -0,0 +1,148 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "TSMoreland.Interop.Portable/string_allocator.h"
+#include "test_harness.h"
+
+using tsmoreland::interop::string_allocator;
+
+namespace {
+    std::atomic<int> live_strings{0};
+
+    /// <summary>
+    /// length prefixed UTF-16 strings laid out as BSTR, counting the strings not yet released
+    /// </summary>
+    struct counting_traits {
+        using char_type   = char16_t;
+        using string_type = char16_t*;
+
+        static char16_t* allocate(char16_t const* const text, std::uint32_t const length) noexcept {
+            auto* const block = new (std::nothrow) std::uint32_t[1 + (length + 2) / 2];
+            if (block == nullptr) {
+                return nullptr;
+            }
+            block[0]           = length * static_cast<std::uint32_t>(sizeof(char16_t));
+            auto* const string   = reinterpret_cast<char16_t*>(block + 1);
+            if (text != nullptr) {
+                std::memcpy(string, text, length * sizeof(char16_t));
+            }
+            string[length] = u'\0';
+            live_strings++;
+            return string;
+        }
+
+        static void release(char16_t* const string) noexcept {
+            if (string != nullptr) {
+                delete[] (reinterpret_cast<std::uint32_t*>(string) - 1);
+                live_strings--;
+            }
+        }
+
+        static char16_t const* data(char16_t* const string) noexcept {
+            return string;
+        }
+    };
+
+    enum class method {
+        get_Name,
+        ToUpper,
+        property_changed,
+        count,
+    };
+
+    using allocator = string_allocator<counting_traits, method>;
+
+    constexpr std::u16string_view name = u"Simple Name";
+} // namespace
+
+TEST_CASE(allocate_returns_new_string_each_call) {
+    int const live_before = live_strings;
+    {
+        allocator strings;
+        char16_t* const first  = strings.allocate(method::get_Name, name);
+        char16_t* const second = strings.allocate(method::get_Name, name);
+
+        CHECK(first != second);
+        CHECK(std::u16string_view{first} == name);
+        CHECK(reinterpret_cast<std::uint32_t const*>(first)[-1] == name.size() * sizeof(char16_t));
+        CHECK(live_strings == live_before + 2);
+
+        counting_traits::release(first);
+        counting_traits::release(second);
+    }
+    CHECK(live_strings == live_before);
+}
+
+TEST_CASE(allocations_and_bytes_are_counted_per_method) {
+    allocator strings;
+    counting_traits::release(strings.allocate(method::get_Name, name));
+    counting_traits::release(strings.allocate(method::get_Name, name));
+    counting_traits::release(strings.allocate(method::ToUpper, std::uint32_t{3}));
+
+    auto const get_name = strings.statistics(method::get_Name);
+    CHECK(get_name.allocations == 2);
+    CHECK(get_name.bytes == 2 * (4 + (name.size() + 1) * 2));
+    auto const to_upper = strings.statistics(method::ToUpper);
+    CHECK(to_upper.allocations == 1 && to_upper.bytes == 4 + 4 * 2);
+    auto const changed = strings.statistics(method::property_changed);
+    CHECK(changed.allocations == 0 && changed.bytes == 0);
+}
+
+TEST_CASE(intern_allocates_once_and_frees_on_destruction) {
+    int const live_before = live_strings;
+    {
+        allocator strings;
+        char16_t* const first = strings.intern(method::property_changed, u"Numeric");
+        for (int i = 0; i < 100; i++) {
+            CHECK(strings.intern(method::property_changed, u"Numeric") == first);
+        }
+        char16_t* const other = strings.intern(method::property_changed, u"Name");
+
+        CHECK(other != first);
+        CHECK(std::u16string_view{first} == u"Numeric");
+        CHECK(strings.statistics(method::property_changed).allocations == 2);
+        CHECK(live_strings == live_before + 2);
+    }
+    CHECK(live_strings == live_before);
+}
+
+TEST_CASE(intern_from_many_threads_allocates_once) {
+    allocator strings;
+    std::vector<char16_t*> seen(8);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < seen.size(); t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 1'000; i++) {
+                seen[t] = strings.intern(method::property_changed, u"Numeric");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(strings.statistics(method::property_changed).allocations == 1);
+    for (char16_t* const interned : seen) {
+        CHECK(interned == seen.front());
+    }
+}
@@ -0,0 +1,84 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tsmoreland::interop::tests {
+
+    struct test_case {
+        std::string_view name;
+        void (*run)();
+    };
+
+    [[nodiscard]]
+    inline std::vector<test_case>& registered_tests() {
+        static std::vector<test_case> tests;
+        return tests;
+    }
+
+    struct test_registration {
+        test_registration(std::string_view const name, void (*run)()) {
+            registered_tests().push_back({name, run});
+        }
+    };
+
+    class test_failure final : public std::runtime_error {
+    public:
+        test_failure(char const* const file, int const line, char const* const expression)
+            : std::runtime_error(std::string(file) + ":" + std::to_string(line) + ": " + expression) {}
+    };
+
+} // namespace tsmoreland::interop::tests
+
+/// <summary>
+/// defines and registers a test, run by main in the order the tests were registered
+/// </summary>
+#define TEST_CASE(name)                                                                                                \
+    static void name();                                                                                                \
+    static ::tsmoreland::interop::tests::test_registration const name##_registration{#name, name};                   \
+    static void name()
+
+/// <summary>
+/// fails the current test if <paramref name="condition"/> is false
+/// </summary>
+#define CHECK(condition)                                                                                               \
+    do {                                                                                                               \
+        if (!(condition)) {                                                                                            \
+            throw ::tsmoreland::interop::tests::test_failure(__FILE__, __LINE__, #condition);                          \
+        }                                                                                                              \
+    } while (false)
+
+/// <summary>
+/// fails the current test unless <paramref name="expression"/> throws <paramref name="exception_type"/>
+/// </summary>
+#define CHECK_THROWS(expression, exception_type)                                                                       \
+    do {                                                                                                               \
+        bool thrown = false;                                                                                           \
+        try {                                                                                                          \
+            static_cast<void>(expression);                                                                             \
+        } catch (exception_type const&) {                                                                              \
+            thrown = true;                                                                                             \
+        }                                                                                                              \
+        if (!thrown) {                                                                                                 \
+            throw ::tsmoreland::interop::tests::test_failure(__FILE__, __LINE__, #expression " did not throw");        \
+        }                                                                                                              \
+    } while (false)
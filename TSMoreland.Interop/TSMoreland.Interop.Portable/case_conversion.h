@@ -0,0 +1,316 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "cpu_features.h"
+#include "unicode_case_data.h"
+
+namespace tsmoreland::interop {
+
+    /// <summary>
+    /// a UTF-16 code unit, <c>char16_t</c> or, on Windows, <c>wchar_t</c> and so the contents of a BSTR
+    /// </summary>
+    template <typename Char>
+    concept utf16_code_unit = std::is_integral_v<Char> && sizeof(Char) == 2;
+
+    namespace details {
+
+        // every code point with a simple upper case mapping is in the first two planes
+        inline constexpr char32_t case_table_limit      = 0x20000;
+        inline constexpr std::size_t case_block_bits    = 7;
+        inline constexpr std::size_t case_block_size    = std::size_t{1} << case_block_bits;
+        inline constexpr std::size_t case_table_entries = case_table_limit / case_block_size;
+
+        constexpr char32_t apply_delta(char32_t const code_point, std::int32_t const delta) noexcept {
+            return static_cast<char32_t>(static_cast<std::int32_t>(code_point) + delta);
+        }
+
+        /// <summary>
+        /// conversion writes one code unit for each code unit read, which holds as long as no mapping crosses
+        /// between the BMP and the supplementary planes; supplementary mappings also keep their high surrogate,
+        /// so a pair is converted by replacing only its low surrogate
+        /// </summary>
+        consteval bool runs_keep_utf16_layout() {
+            for (case_mapping_run const& run : simple_upper_case_runs) {
+                for (char32_t code_point = run.first; code_point <= run.last; code_point += run.stride) {
+                    char32_t const upper = apply_delta(code_point, run.delta);
+                    if (code_point >= case_table_limit || (code_point < 0x10000) != (upper < 0x10000)) {
+                        return false;
+                    }
+                    if (code_point >= 0x10000 && (code_point - 0x10000) >> 10 != (upper - 0x10000) >> 10) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+        static_assert(runs_keep_utf16_layout(), "a simple upper case mapping would change the UTF-16 length");
+
+        consteval std::size_t count_distinct_deltas() {
+            std::array<std::int32_t, simple_upper_case_runs.size() + 1> deltas{};
+            std::size_t count = 1; // deltas[0] is the identity mapping shared by every unmapped code point
+            for (case_mapping_run const& run : simple_upper_case_runs) {
+                auto const end = deltas.begin() + static_cast<std::ptrdiff_t>(count);
+                if (std::find(deltas.begin(), end, run.delta) == end) {
+                    deltas[count++] = run.delta;
+                }
+            }
+            return count;
+        }
+
+        consteval std::size_t count_mapped_blocks() {
+            std::array<bool, case_table_entries> mapped{};
+            std::size_t count = 1; // block 0 is the identity block shared by every unmapped block
+            for (case_mapping_run const& run : simple_upper_case_runs) {
+                for (char32_t code_point = run.first; code_point <= run.last; code_point += run.stride) {
+                    if (!mapped[code_point >> case_block_bits]) {
+                        mapped[code_point >> case_block_bits] = true;
+                        count++;
+                    }
+                }
+            }
+            return count;
+        }
+
+        /// <summary>
+        /// two level lookup of the simple upper case mapping: the block of 128 code points selects a row of
+        /// delta indices, the index selects the delta to add to the code point
+        /// </summary>
+        template <std::size_t DeltaCount, std::size_t BlockCount>
+        struct upper_case_table {
+            static_assert(DeltaCount <= 256 && BlockCount <= 256, "indices are stored as bytes");
+
+            std::array<std::int32_t, DeltaCount> deltas{};
+            std::array<std::uint8_t, case_table_entries> blocks{};
+            std::array<std::uint8_t, BlockCount * case_block_size> delta_indices{};
+
+            [[nodiscard]]
+            constexpr char32_t to_upper(char32_t const code_point) const noexcept {
+                if (code_point >= case_table_limit) {
+                    return code_point;
+                }
+                std::size_t const row = std::size_t{blocks[code_point >> case_block_bits]} * case_block_size;
+                return apply_delta(code_point, deltas[delta_indices[row + (code_point & (case_block_size - 1))]]);
+            }
+        };
+
+        /// <summary>
+        /// built by the compiler from <see cref="simple_upper_case_runs"/>, around 7KB
+        /// </summary>
+        inline constexpr auto simple_upper_case_table = [] {
+            upper_case_table<count_distinct_deltas(), count_mapped_blocks()> table{};
+            std::size_t delta_count = 1;
+            std::size_t block_count = 1;
+            for (case_mapping_run const& run : simple_upper_case_runs) {
+                auto const end = table.deltas.begin() + static_cast<std::ptrdiff_t>(delta_count);
+                auto const delta_index =
+                    static_cast<std::size_t>(std::find(table.deltas.begin(), end, run.delta) - table.deltas.begin());
+                if (delta_index == delta_count) {
+                    table.deltas[delta_count++] = run.delta;
+                }
+
+                for (char32_t code_point = run.first; code_point <= run.last; code_point += run.stride) {
+                    std::uint8_t& block = table.blocks[code_point >> case_block_bits];
+                    if (block == 0) {
+                        block = static_cast<std::uint8_t>(block_count++);
+                    }
+                    std::size_t const row = std::size_t{block} * case_block_size;
+                    table.delta_indices[row + (code_point & (case_block_size - 1))] =
+                        static_cast<std::uint8_t>(delta_index);
+                }
+            }
+            return table;
+        }();
+
+        constexpr bool is_high_surrogate(char32_t const unit) noexcept {
+            return unit >= 0xD800 && unit <= 0xDBFF;
+        }
+
+        constexpr bool is_low_surrogate(char32_t const unit) noexcept {
+            return unit >= 0xDC00 && unit <= 0xDFFF;
+        }
+
+        template <utf16_code_unit Char>
+        constexpr char32_t code_unit_at(Char const* input, std::size_t const position) noexcept {
+            return static_cast<char32_t>(static_cast<std::uint16_t>(input[position]));
+        }
+
+        /// <summary>
+        /// the upper case form of the code unit at <paramref name="position"/>; a low surrogate following a high
+        /// surrogate is converted as part of the pair, anything else including unpaired surrogates as a BMP
+        /// code point (surrogates map to themselves)
+        /// </summary>
+        /// <remarks>
+        /// only looks back, and high surrogates are never changed, so this is correct when converting in place
+        /// </remarks>
+        template <utf16_code_unit Char>
+        constexpr Char to_upper_code_unit(Char const* input, std::size_t const position) noexcept {
+            char32_t const unit = code_unit_at(input, position);
+            if (is_low_surrogate(unit) && position > 0) {
+                char32_t const high = code_unit_at(input, position - 1);
+                if (is_high_surrogate(high)) {
+                    char32_t const code_point = 0x10000 + ((high - 0xD800) << 10) + (unit - 0xDC00);
+                    char32_t const upper      = simple_upper_case_table.to_upper(code_point);
+                    return static_cast<Char>(0xDC00 + ((upper - 0x10000) & 0x3FF));
+                }
+            }
+            return static_cast<Char>(simple_upper_case_table.to_upper(unit));
+        }
+
+        template <utf16_code_unit Char>
+        constexpr void to_upper_scalar(
+            Char const* input, Char* output, std::size_t const begin, std::size_t const end) noexcept {
+            for (std::size_t i = begin; i < end; i++) {
+                output[i] = to_upper_code_unit(input, i);
+            }
+        }
+
+#ifdef TSMORELAND_INTEROP_X86
+
+        /// <summary>
+        /// upper cases a-z in each 16-bit lane, other lanes are unchanged; code units of 0x8000 and above are
+        /// negative in the signed compares so they're never taken for lower case letters
+        /// </summary>
+        inline __m128i to_upper_ascii_sse2(__m128i const units) noexcept {
+            __m128i const lower = _mm_and_si128(
+                _mm_cmpgt_epi16(units, _mm_set1_epi16('a' - 1)), _mm_cmplt_epi16(units, _mm_set1_epi16('z' + 1)));
+            return _mm_sub_epi16(units, _mm_and_si128(lower, _mm_set1_epi16(0x20)));
+        }
+
+        /// <returns>a mask with two bits set for each lane holding a code unit outside ASCII</returns>
+        inline std::uint32_t non_ascii_mask_sse2(__m128i const units) noexcept {
+            __m128i const high_bits = _mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xFF80)));
+            return ~static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(high_bits, _mm_setzero_si128()))) &
+                   0xFFFFU;
+        }
+
+        /// <remarks>
+        /// each block of 8 code units is converted in registers while the text is ASCII; from the first block
+        /// holding a code unit outside ASCII the rest is left to the scalar conversion, as text with one non-ASCII
+        /// letter usually has more and fixing up those lanes after the vector conversion is slower than the
+        /// scalar loop alone
+        /// </remarks>
+        template <utf16_code_unit Char>
+        void to_upper_sse2(
+            Char const* input, Char* output, std::size_t const begin, std::size_t const end) noexcept {
+            std::size_t i = begin;
+            for (; i + 8 <= end; i += 8) {
+                __m128i const units           = _mm_loadu_si128(reinterpret_cast<__m128i const*>(input + i));
+                std::uint32_t const non_ascii = non_ascii_mask_sse2(units);
+                if (non_ascii != 0) {
+                    to_upper_scalar(input, output, i, end);
+                    return;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), to_upper_ascii_sse2(units));
+            }
+            to_upper_scalar(input, output, i, end);
+        }
+
+        TSMORELAND_INTEROP_TARGET_AVX2
+        inline __m256i to_upper_ascii_avx2(__m256i const units) noexcept {
+            __m256i const lower = _mm256_andnot_si256(_mm256_cmpgt_epi16(units, _mm256_set1_epi16('z')),
+                _mm256_cmpgt_epi16(units, _mm256_set1_epi16('a' - 1)));
+            return _mm256_sub_epi16(units, _mm256_and_si256(lower, _mm256_set1_epi16(0x20)));
+        }
+
+        TSMORELAND_INTEROP_TARGET_AVX2
+        inline std::uint32_t non_ascii_mask_avx2(__m256i const units) noexcept {
+            __m256i const high_bits = _mm256_and_si256(units, _mm256_set1_epi16(static_cast<short>(0xFF80)));
+            return ~static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi16(high_bits, _mm256_setzero_si256())));
+        }
+
+        /// <remarks>as <see cref="to_upper_sse2"/> with blocks of 16, the remainder is left to sse2</remarks>
+        template <utf16_code_unit Char>
+        TSMORELAND_INTEROP_TARGET_AVX2 void to_upper_avx2(
+            Char const* input, Char* output, std::size_t const begin, std::size_t const end) noexcept {
+            std::size_t i = begin;
+            for (; i + 16 <= end; i += 16) {
+                __m256i const units           = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(input + i));
+                std::uint32_t const non_ascii = non_ascii_mask_avx2(units);
+                if (non_ascii != 0) {
+                    to_upper_scalar(input, output, i, end);
+                    return;
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), to_upper_ascii_avx2(units));
+            }
+            to_upper_sse2(input, output, i, end);
+        }
+
+#endif
+
+    } // namespace details
+
+    /// <returns>
+    /// the simple upper case mapping of <paramref name="code_point"/> from the Unicode character database, which
+    /// doesn't depend on the locale
+    /// </returns>
+    [[nodiscard]]
+    constexpr char32_t to_upper(char32_t const code_point) noexcept {
+        return details::simple_upper_case_table.to_upper(code_point);
+    }
+
+    /// <summary>
+    /// writes the upper case form of <paramref name="input"/> to the start of <paramref name="output"/>, one
+    /// code unit out for each code unit in; ASCII is converted in vector registers
+    /// </summary>
+    /// <param name="output">
+    /// at least as large as <paramref name="input"/>, which it may be to convert in place
+    /// </param>
+    /// <remarks>
+    /// code points outside ASCII use the simple upper case mapping, see <see cref="to_upper(char32_t)"/>, surrogate
+    /// pairs are converted as one code point and unpaired surrogates are copied unchanged
+    /// </remarks>
+    /// <exception cref="std::invalid_argument">
+    /// if <paramref name="output"/> is too small or <paramref name="kernel"/> isn't supported
+    /// </exception>
+    template <utf16_code_unit Char>
+    void to_upper(std::basic_string_view<Char> const input, std::span<Char> const output,
+        simd_kernel const kernel = best_simd_kernel()) {
+        if (!is_supported(kernel)) {
+            throw std::invalid_argument("kernel is not supported by this processor");
+        }
+        if (output.size() < input.size()) {
+            throw std::invalid_argument("output must be at least as large as input");
+        }
+
+        switch (kernel) {
+#ifdef TSMORELAND_INTEROP_X86
+        case simd_kernel::avx2:
+            details::to_upper_avx2(input.data(), output.data(), 0, input.size());
+            break;
+        case simd_kernel::sse2:
+            details::to_upper_sse2(input.data(), output.data(), 0, input.size());
+            break;
+#endif
+        default:
+            details::to_upper_scalar(input.data(), output.data(), 0, input.size());
+            break;
+        }
+    }
+
+} // namespace tsmoreland::interop
@@ -0,0 +1,252 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+namespace tsmoreland::interop {
+
+    /// <summary>
+    /// counters of a <see cref="coalescing_dispatcher"/>, every post is either delivered, coalesced or dropped
+    /// </summary>
+    struct dispatcher_statistics {
+        std::size_t queue_depth;
+        std::uint64_t posted;
+        std::uint64_t delivered;
+        std::uint64_t coalesced;
+        std::uint64_t dropped;
+    };
+
+    /// <summary>
+    /// default for the scope a <see cref="coalescing_dispatcher"/> holds on its thread, does nothing
+    /// </summary>
+    struct no_thread_scope {};
+
+    /// <summary>
+    /// outcome of <see cref="coalescing_dispatcher::post"/>
+    /// </summary>
+    enum class post_result {
+        queued,
+        coalesced,
+        dropped,
+    };
+
+    namespace details {
+        template <typename Key, typename Hash>
+        struct dispatcher_state {
+            std::function<void(Key const&)> handler;
+            std::size_t capacity;
+
+            std::mutex lock;
+            std::condition_variable wake;
+            std::condition_variable idle;
+            std::deque<Key> queue;
+            std::unordered_set<Key, Hash> pending;
+            bool delivering{false};
+            bool stopping{false};
+            bool discard{false};
+            dispatcher_statistics statistics{};
+        };
+
+        template <typename Key, typename Hash, typename ThreadScope>
+        void run_dispatcher(std::shared_ptr<dispatcher_state<Key, Hash>> const state) {
+            [[maybe_unused]] ThreadScope const scope{};
+
+            std::unique_lock guard{state->lock};
+            while (true) {
+                state->wake.wait(guard, [&state] { return !state->queue.empty() || state->stopping; });
+                if (state->discard) {
+                    state->statistics.dropped += state->queue.size();
+                    state->queue.clear();
+                    state->pending.clear();
+                }
+                if (state->queue.empty()) {
+                    break;
+                }
+
+                // removed from pending before delivery, a change made while the handler runs is delivered again
+                Key const key = std::move(state->queue.front());
+                state->queue.pop_front();
+                state->pending.erase(key);
+                state->delivering = true;
+                guard.unlock();
+
+                try {
+                    state->handler(key);
+                } catch (...) {
+                    // a failing handler loses this notification, not the ones after it
+                }
+
+                guard.lock();
+                state->delivering = false;
+                state->statistics.delivered++;
+                if (state->queue.empty()) {
+                    state->idle.notify_all();
+                }
+            }
+            state->idle.notify_all();
+        }
+    } // namespace details
+
+    /// <summary>
+    /// delivers keys posted from any thread to a handler on a single dispatcher thread, through a bounded queue
+    /// in which a key is held at most once: posting a key that is already waiting coalesces with it
+    /// </summary>
+    /// <remarks>
+    /// intended for change notifications that name what changed rather than carrying the new value, where one
+    /// delivery after any number of changes is enough; a post to a full queue is dropped
+    /// </remarks>
+    /// <typeparam name="ThreadScope">
+    /// default constructed on the dispatcher thread before the first delivery and destroyed after the last
+    /// </typeparam>
+    template <typename Key, typename ThreadScope = no_thread_scope, typename Hash = std::hash<Key>>
+    class coalescing_dispatcher final {
+    public:
+        using handler_type = std::function<void(Key const&)>;
+
+        /// <summary>
+        /// starts the dispatcher thread
+        /// </summary>
+        /// <param name="capacity">maximum number of distinct keys waiting for delivery</param>
+        /// <param name="handler">
+        /// called on the dispatcher thread with each key, exceptions it throws are ignored
+        /// </param>
+        /// <exception cref="std::invalid_argument">if capacity is 0 or handler is empty</exception>
+        /// <exception cref="std::system_error">if the thread can't be started</exception>
+        coalescing_dispatcher(std::size_t const capacity, handler_type handler)
+            : state_{std::make_shared<state_type>()} {
+            if (capacity == 0) {
+                throw std::invalid_argument("capacity must be greater than 0");
+            }
+            if (!handler) {
+                throw std::invalid_argument("handler is required");
+            }
+            state_->capacity = capacity;
+            state_->handler  = std::move(handler);
+            thread_          = std::thread{details::run_dispatcher<Key, Hash, ThreadScope>, state_};
+            thread_id_       = thread_.get_id();
+        }
+
+        coalescing_dispatcher(coalescing_dispatcher const&)            = delete;
+        coalescing_dispatcher& operator=(coalescing_dispatcher const&) = delete;
+
+        ~coalescing_dispatcher() {
+            stop();
+        }
+
+        /// <summary>
+        /// queues <paramref name="key"/> for delivery unless it is already waiting or the queue is full
+        /// </summary>
+        /// <returns>
+        /// how the post was handled, posts after <see cref="stop"/> are dropped
+        /// </returns>
+        post_result post(Key key) {
+            std::scoped_lock const guard{state_->lock};
+            auto& statistics = state_->statistics;
+            statistics.posted++;
+
+            if (state_->stopping) {
+                statistics.dropped++;
+                return post_result::dropped;
+            }
+            if (state_->pending.contains(key)) {
+                statistics.coalesced++;
+                return post_result::coalesced;
+            }
+            if (state_->queue.size() >= state_->capacity) {
+                statistics.dropped++;
+                return post_result::dropped;
+            }
+
+            state_->pending.insert(key);
+            state_->queue.push_back(std::move(key));
+            state_->wake.notify_one();
+            return post_result::queued;
+        }
+
+        /// <summary>
+        /// blocks until every queued key has been delivered, returns immediately on the dispatcher thread
+        /// </summary>
+        void flush() {
+            if (is_dispatcher_thread()) {
+                return;
+            }
+            std::unique_lock guard{state_->lock};
+            state_->idle.wait(guard, [this] {
+                return (state_->queue.empty() && !state_->delivering) || state_->stopping;
+            });
+        }
+
+        /// <summary>
+        /// delivers the keys already queued then stops the dispatcher thread, later posts are dropped
+        /// </summary>
+        /// <remarks>
+        /// called from the handler, the keys still queued are dropped and the thread exits once the handler
+        /// returns; the rest of that handler call must not use anything its owner destroys after stopping
+        /// </remarks>
+        void stop() noexcept {
+            bool const from_handler = is_dispatcher_thread();
+            {
+                std::scoped_lock const guard{state_->lock};
+                state_->stopping = true;
+                state_->discard  = state_->discard || from_handler;
+            }
+            state_->wake.notify_all();
+
+            if (!thread_.joinable()) {
+                return;
+            }
+            if (from_handler) {
+                thread_.detach();
+            } else {
+                thread_.join();
+            }
+        }
+
+        [[nodiscard]]
+        dispatcher_statistics statistics() const {
+            std::scoped_lock const guard{state_->lock};
+            dispatcher_statistics statistics = state_->statistics;
+            statistics.queue_depth = state_->queue.size();
+            return statistics;
+        }
+
+        /// <returns>true if called from the handler, on the dispatcher thread</returns>
+        [[nodiscard]]
+        bool is_dispatcher_thread() const noexcept {
+            return thread_id_ == std::this_thread::get_id();
+        }
+
+    private:
+        using state_type = details::dispatcher_state<Key, Hash>;
+
+        std::shared_ptr<state_type> state_;
+        std::thread thread_;
+        std::thread::id thread_id_;
+    };
+
+} // namespace tsmoreland::interop
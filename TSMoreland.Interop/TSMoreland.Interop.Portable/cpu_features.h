@@ -0,0 +1,94 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define TSMORELAND_INTEROP_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC allows intrinsics of any instruction set in any function, gcc and clang need the target enabling per function
+#if defined(__GNUC__) || defined(__clang__)
+#define TSMORELAND_INTEROP_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TSMORELAND_INTEROP_TARGET_AVX2
+#endif
+
+namespace tsmoreland::interop {
+
+    /// <summary>
+    /// instruction sets the vectorised kernels can use, sse2 and avx2 are only available on x86 and x64
+    /// </summary>
+    enum class simd_kernel {
+        scalar,
+        sse2,
+        avx2,
+    };
+
+    namespace details {
+#ifdef TSMORELAND_INTEROP_X86
+        inline bool cpu_supports_avx2() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int registers[4]{};
+            __cpuid(registers, 0);
+            if (registers[0] < 7) {
+                return false;
+            }
+            __cpuid(registers, 1);
+            bool const os_saves_ymm = (registers[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+            __cpuidex(registers, 7, 0);
+            return os_saves_ymm && (registers[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif
+    } // namespace details
+
+    /// <returns>true if <paramref name="kernel"/> can run on this processor</returns>
+    [[nodiscard]]
+    inline bool is_supported(simd_kernel const kernel) noexcept {
+        switch (kernel) {
+        case simd_kernel::scalar:
+            return true;
+#ifdef TSMORELAND_INTEROP_X86
+        case simd_kernel::sse2:
+            // part of the x64 baseline; 32-bit builds are assumed to target it too
+            return true;
+        case simd_kernel::avx2: {
+            static bool const supported = details::cpu_supports_avx2();
+            return supported;
+        }
+#endif
+        default:
+            return false;
+        }
+    }
+
+    /// <returns>the widest kernel this processor supports, detected once</returns>
+    [[nodiscard]]
+    inline simd_kernel best_simd_kernel() noexcept {
+        static simd_kernel const best = is_supported(simd_kernel::avx2)   ? simd_kernel::avx2
+                                        : is_supported(simd_kernel::sse2) ? simd_kernel::sse2
+                                                                          : simd_kernel::scalar;
+        return best;
+    }
+
+} // namespace tsmoreland::interop
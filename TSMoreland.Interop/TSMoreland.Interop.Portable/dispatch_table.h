@@ -0,0 +1,451 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+#ifdef _WIN32
+#include <oleauto.h>
+#endif
+
+namespace tsmoreland::interop {
+
+    /// <summary>
+    /// a member name as IDispatch::GetIDsOfNames is given it and the DISPID it maps to
+    /// </summary>
+    struct dispatch_name {
+        std::wstring_view name;
+        std::int32_t id;
+    };
+
+    namespace details {
+        /// <summary>
+        /// member names are matched without regard to case, as the type library matches them; only ASCII letters
+        /// are folded as no member name uses any other
+        /// </summary>
+        [[nodiscard]]
+        constexpr wchar_t fold_dispatch_case(wchar_t const unit) noexcept {
+            return unit >= L'a' && unit <= L'z' ? static_cast<wchar_t>(unit - (L'a' - L'A')) : unit;
+        }
+
+        [[nodiscard]]
+        constexpr bool dispatch_names_equal(std::wstring_view const left, std::wstring_view const right) noexcept {
+            if (left.size() != right.size()) {
+                return false;
+            }
+            // callers normally use the declared case
+            if (left == right) {
+                return true;
+            }
+            for (std::size_t i = 0; i < left.size(); i++) {
+                if (fold_dispatch_case(left[i]) != fold_dispatch_case(right[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// hashes the length and the first, middle and last code units of the case folded name, as gperf does, so
+        /// only the comparison that confirms a match reads the whole name
+        /// </summary>
+        [[nodiscard]]
+        constexpr std::uint32_t dispatch_name_hash(std::wstring_view const name, std::uint32_t const seed) noexcept {
+            auto const mix = [](std::uint32_t const hash, std::uint32_t const value) {
+                return (hash ^ value) * 0x9E37'79B1U;
+            };
+
+            std::uint32_t hash = mix(seed, static_cast<std::uint32_t>(name.size()));
+            if (!name.empty()) {
+                hash = mix(hash, static_cast<std::uint32_t>(fold_dispatch_case(name.front())));
+                hash = mix(hash, static_cast<std::uint32_t>(fold_dispatch_case(name[name.size() / 2])));
+                hash = mix(hash, static_cast<std::uint32_t>(fold_dispatch_case(name.back())));
+            }
+            return hash ^ (hash >> 16);
+        }
+    } // namespace details
+
+    /// <summary>
+    /// maps member names to DISPID with a single hash and one comparison: the seed of the hash is searched for
+    /// when the map is built, normally at compile time, until every name has a slot of its own
+    /// </summary>
+    template <std::size_t Count>
+    class perfect_hash_map final {
+    public:
+        static_assert(Count > 0 && Count < std::numeric_limits<std::uint16_t>::max());
+
+        /// <summary>
+        /// slots in the table, 4 per name keeps the seed search short
+        /// </summary>
+        static constexpr std::size_t table_size = std::bit_ceil(Count * 4);
+
+        /// <exception cref="std::invalid_argument">
+        /// if two names are equal ignoring case or no seed gives every name its own slot, as when two names share
+        /// their length and the code units hashed; at compile time either fails the build
+        /// </exception>
+        constexpr explicit perfect_hash_map(std::array<dispatch_name, Count> const& names) : names_{names} {
+            for (std::size_t i = 0; i < Count; i++) {
+                for (std::size_t j = i + 1; j < Count; j++) {
+                    if (details::dispatch_names_equal(names_[i].name, names_[j].name)) {
+                        throw std::invalid_argument("dispatch names must be unique");
+                    }
+                }
+            }
+
+            constexpr std::uint32_t max_seed = 1U << 16;
+            for (std::uint32_t seed = 0; seed < max_seed; seed++) {
+                if (try_seed(seed)) {
+                    return;
+                }
+            }
+            throw std::invalid_argument("no seed gives each dispatch name its own slot");
+        }
+
+        /// <returns>the DISPID of <paramref name="name"/>, or nullopt if it isn't a member</returns>
+        [[nodiscard]]
+        constexpr std::optional<std::int32_t> find(std::wstring_view const name) const noexcept {
+            std::uint16_t const slot = slots_[details::dispatch_name_hash(name, seed_) & (table_size - 1)];
+            if (slot == 0 || !details::dispatch_names_equal(names_[slot - 1].name, name)) {
+                return std::nullopt;
+            }
+            return names_[slot - 1].id;
+        }
+
+        [[nodiscard]]
+        constexpr std::uint32_t seed() const noexcept {
+            return seed_;
+        }
+
+    private:
+        constexpr bool try_seed(std::uint32_t const seed) {
+            slots_ = {};
+            for (std::size_t i = 0; i < Count; i++) {
+                std::uint16_t& slot = slots_[details::dispatch_name_hash(names_[i].name, seed) & (table_size - 1)];
+                if (slot != 0) {
+                    return false;
+                }
+                slot = static_cast<std::uint16_t>(i + 1);
+            }
+            seed_ = seed;
+            return true;
+        }
+
+        std::array<dispatch_name, Count> names_;
+        // index into names_ plus 1, 0 for an empty slot
+        std::array<std::uint16_t, table_size> slots_{};
+        std::uint32_t seed_{};
+    };
+
+    template <std::size_t Count>
+    perfect_hash_map(std::array<dispatch_name, Count> const&) -> perfect_hash_map<Count>;
+
+#ifdef _WIN32
+    /// <returns>
+    /// the argument at <paramref name="position"/> counted from the first, DISPPARAMS holds them last first; null
+    /// if there are too few
+    /// </returns>
+    [[nodiscard]]
+    inline VARIANTARG const* positional_argument(DISPPARAMS const& params, UINT const position) noexcept {
+        return position < params.cArgs ? &params.rgvarg[params.cArgs - 1 - position] : nullptr;
+    }
+
+    /// <summary>
+    /// reads <paramref name="argument"/> as a LONG, directly when it already is one and with VariantChangeType
+    /// otherwise
+    /// </summary>
+    /// <returns>S_OK on success, otherwise the failure from VariantChangeType such as DISP_E_TYPEMISMATCH</returns>
+    inline HRESULT coerce_argument(VARIANTARG const& argument, LONG& value) noexcept {
+        if (argument.vt == VT_I4) {
+            value = argument.lVal;
+            return S_OK;
+        }
+        if (argument.vt == (VT_I4 | VT_BYREF)) {
+            value = *argument.plVal;
+            return S_OK;
+        }
+
+        VARIANT converted;
+        ::VariantInit(&converted);
+        HRESULT const hr = ::VariantChangeType(&converted, &argument, 0, VT_I4);
+        if (SUCCEEDED(hr)) {
+            value = converted.lVal;
+        }
+        return hr;
+    }
+
+    /// <summary>
+    /// reads <paramref name="argument"/> as a VARIANT_BOOL, as the LONG overload
+    /// </summary>
+    inline HRESULT coerce_argument(VARIANTARG const& argument, VARIANT_BOOL& value) noexcept {
+        if (argument.vt == VT_BOOL) {
+            value = argument.boolVal;
+            return S_OK;
+        }
+        if (argument.vt == (VT_BOOL | VT_BYREF)) {
+            value = *argument.pboolVal;
+            return S_OK;
+        }
+
+        VARIANT converted;
+        ::VariantInit(&converted);
+        HRESULT const hr = ::VariantChangeType(&converted, &argument, 0, VT_BOOL);
+        if (SUCCEEDED(hr)) {
+            value = converted.boolVal;
+        }
+        return hr;
+    }
+
+    /// <summary>
+    /// reads <paramref name="argument"/> as a BSTR, borrowed when it already is one and converted into
+    /// <paramref name="storage"/> otherwise
+    /// </summary>
+    /// <param name="storage">holds a converted string, the caller clears it once done with the value</param>
+    inline HRESULT coerce_argument(VARIANTARG const& argument, BSTR& value, VARIANT& storage) noexcept {
+        if (argument.vt == VT_BSTR) {
+            value = argument.bstrVal;
+            return S_OK;
+        }
+        if (argument.vt == (VT_BSTR | VT_BYREF)) {
+            value = *argument.pbstrVal;
+            return S_OK;
+        }
+
+        HRESULT const hr = ::VariantChangeType(&storage, &argument, 0, VT_BSTR);
+        if (SUCCEEDED(hr)) {
+            value = storage.bstrVal;
+        }
+        return hr;
+    }
+
+    /// <summary>
+    /// reads the argument at <paramref name="position"/>, which must be present, with <see cref="coerce_argument"/>
+    /// and records its index in <paramref name="argument_error"/> if it can't be converted
+    /// </summary>
+    template <typename T, typename... Storage>
+    HRESULT coerce_positional_argument(DISPPARAMS const& params, UINT const position, UINT* const argument_error,
+        T& value, Storage&... storage) noexcept {
+        HRESULT const hr = coerce_argument(*positional_argument(params, position), value, storage...);
+        if (FAILED(hr) && argument_error != nullptr) {
+            *argument_error = params.cArgs - 1 - position;
+        }
+        return hr;
+    }
+
+    /// <summary>
+    /// stores <paramref name="value"/> in <paramref name="result"/>, or frees it if the caller didn't ask for the
+    /// result
+    /// </summary>
+    inline void store_result(VARIANT* const result, BSTR const value) noexcept {
+        if (result == nullptr) {
+            ::SysFreeString(value);
+            return;
+        }
+        result->vt      = VT_BSTR;
+        result->bstrVal = value;
+    }
+
+    inline void store_result(VARIANT* const result, LONG const value) noexcept {
+        if (result != nullptr) {
+            result->vt   = VT_I4;
+            result->lVal = value;
+        }
+    }
+
+    inline void store_result(VARIANT* const result, VARIANT_BOOL const value) noexcept {
+        if (result != nullptr) {
+            result->vt      = VT_BOOL;
+            result->boolVal = value;
+        }
+    }
+
+    /// <summary>
+    /// the result of a member called by IDispatch::Invoke, as ITypeInfo::Invoke reports it for an object without
+    /// ISupportErrorInfo: a failure becomes DISP_E_EXCEPTION with its HRESULT in <paramref name="exception"/>
+    /// </summary>
+    inline HRESULT dispatch_result(HRESULT const hr, EXCEPINFO* const exception) noexcept {
+        if (SUCCEEDED(hr)) {
+            return hr;
+        }
+        if (exception != nullptr) {
+            *exception       = EXCEPINFO{};
+            exception->scode = hr;
+        }
+        return DISP_E_EXCEPTION;
+    }
+
+    /// <summary>
+    /// calls a member that takes only its result, storing the value in <paramref name="result"/>; failures are
+    /// reported as <see cref="dispatch_result"/>
+    /// </summary>
+    template <typename T, typename Object>
+    HRESULT dispatch_get(Object& object, HRESULT (STDMETHODCALLTYPE Object::*get)(T*) noexcept, VARIANT* result,
+        EXCEPINFO* exception) noexcept {
+        T value{};
+        HRESULT const hr = (object.*get)(&value);
+        if (SUCCEEDED(hr)) {
+            store_result(result, value);
+        }
+        return dispatch_result(hr, exception);
+    }
+
+    /// <summary>
+    /// the DISPIDs of the members both servers implement, each server's type library numbers them differently
+    /// </summary>
+    struct common_dispids {
+        DISPID name;
+        DISPID numeric;
+        DISPID description;
+        DISPID to_upper;
+        DISPID async_events;
+        DISPID add_numeric;
+        DISPID compare_exchange_numeric;
+    };
+
+    /// <summary>
+    /// how IDispatch::Invoke was asked to call a member, for the members called without the type library
+    /// </summary>
+    struct dispatch_call {
+        DISPPARAMS const& arguments;
+        UINT count;
+        bool get;
+        bool method;
+        bool put;
+
+        // a property get may be made as a method call
+        dispatch_call(WORD const flags, DISPPARAMS const& params) noexcept
+            : arguments{params}
+            , count{params.cArgs}
+            , get{(flags & (DISPATCH_PROPERTYGET | DISPATCH_METHOD)) != 0 && params.cNamedArgs == 0}
+            , method{(flags & DISPATCH_METHOD) != 0 && params.cNamedArgs == 0}
+            , put{(flags & DISPATCH_PROPERTYPUT) != 0 && params.cArgs == 1 && params.cNamedArgs == 1 &&
+                  params.rgdispidNamedArgs[0] == DISPID_PROPERTYPUT} {}
+    };
+
+    /// <summary>
+    /// calls the members both servers implement directly, converting their arguments inline; argument conversion
+    /// failures are returned as they are, failures of the member itself as <see cref="dispatch_result"/>
+    /// </summary>
+    /// <returns>
+    /// the result of the call, or std::nullopt if <paramref name="id"/> isn't one of the members or the call is
+    /// left to the type library, such as one with named arguments
+    /// </returns>
+    template <common_dispids Ids, typename Object>
+    std::optional<HRESULT> invoke_common_member(Object& object, DISPID const id, dispatch_call const& call,
+        VARIANT* const result, EXCEPINFO* const exception, UINT* const argument_error) noexcept {
+        DISPPARAMS const& arguments = call.arguments;
+
+        switch (id) {
+        case Ids.name:
+            if (call.get && call.count == 0) {
+                return dispatch_get(object, &Object::get_Name, result, exception);
+            }
+            break;
+        case Ids.numeric:
+            if (call.get && call.count == 0) {
+                return dispatch_get(object, &Object::get_Numeric, result, exception);
+            }
+            if (call.put) {
+                LONG value{};
+                if (HRESULT const hr = coerce_positional_argument(arguments, 0, argument_error, value); FAILED(hr)) {
+                    return hr;
+                }
+                return dispatch_result(object.put_Numeric(value), exception);
+            }
+            break;
+        case Ids.description:
+            if (call.get && call.count == 0) {
+                return dispatch_get(object, &Object::get_Description, result, exception);
+            }
+            break;
+        case Ids.to_upper:
+            if (call.method && call.count == 1) {
+                BSTR input{};
+                VARIANT storage;
+                ::VariantInit(&storage);
+                HRESULT hr = coerce_positional_argument(arguments, 0, argument_error, input, storage);
+                if (FAILED(hr)) {
+                    ::VariantClear(&storage);
+                    return hr;
+                }
+                BSTR upper{};
+                hr = object.ToUpper(input, &upper);
+                ::VariantClear(&storage);
+                if (SUCCEEDED(hr)) {
+                    store_result(result, upper);
+                }
+                return dispatch_result(hr, exception);
+            }
+            break;
+        case Ids.async_events:
+            if (call.get && call.count == 0) {
+                return dispatch_get(object, &Object::get_AsyncEvents, result, exception);
+            }
+            if (call.put) {
+                VARIANT_BOOL value{};
+                if (HRESULT const hr = coerce_positional_argument(arguments, 0, argument_error, value); FAILED(hr)) {
+                    return hr;
+                }
+                return dispatch_result(object.put_AsyncEvents(value), exception);
+            }
+            break;
+        case Ids.add_numeric:
+            if (call.method && call.count == 1) {
+                LONG delta{};
+                if (HRESULT const hr = coerce_positional_argument(arguments, 0, argument_error, delta); FAILED(hr)) {
+                    return hr;
+                }
+                LONG sum{};
+                HRESULT const hr = object.AddNumeric(delta, &sum);
+                if (SUCCEEDED(hr)) {
+                    store_result(result, sum);
+                }
+                return dispatch_result(hr, exception);
+            }
+            break;
+        case Ids.compare_exchange_numeric:
+            if (call.method && call.count == 2) {
+                LONG value{};
+                LONG comparand{};
+                if (HRESULT const hr = coerce_positional_argument(arguments, 0, argument_error, value); FAILED(hr)) {
+                    return hr;
+                }
+                if (HRESULT const hr = coerce_positional_argument(arguments, 1, argument_error, comparand);
+                    FAILED(hr)) {
+                    return hr;
+                }
+                LONG original{};
+                HRESULT const hr = object.CompareExchangeNumeric(value, comparand, &original);
+                if (SUCCEEDED(hr)) {
+                    store_result(result, original);
+                }
+                return dispatch_result(hr, exception);
+            }
+            break;
+        default:
+            break;
+        }
+        return std::nullopt;
+    }
+#endif
+
+} // namespace tsmoreland::interop
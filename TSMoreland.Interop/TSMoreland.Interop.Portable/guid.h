@@ -0,0 +1,222 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <guiddef.h>
+#endif
+
+namespace tsmoreland::interop {
+
+    /// <summary>
+    /// portable equivalent of the Windows GUID, with the same fields in the same order
+    /// </summary>
+    struct guid {
+        std::uint32_t data1{};
+        std::uint16_t data2{};
+        std::uint16_t data3{};
+        std::array<std::uint8_t, 8> data4{};
+
+        friend constexpr bool operator==(guid const&, guid const&) noexcept = default;
+    };
+
+    namespace details {
+
+        // value of each hex digit, 0xFF for anything else
+        inline constexpr auto hex_digit_values = [] {
+            std::array<std::uint8_t, 256> values{};
+            values.fill(0xFF);
+            for (std::uint8_t digit = 0; digit < 10; digit++) {
+                values['0' + digit] = digit;
+            }
+            for (std::uint8_t digit = 0; digit < 6; digit++) {
+                values['a' + digit] = static_cast<std::uint8_t>(10 + digit);
+                values['A' + digit] = static_cast<std::uint8_t>(10 + digit);
+            }
+            return values;
+        }();
+
+        // offset of the first digit of each byte in "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx"
+        inline constexpr std::array<std::size_t, 16> byte_offsets{
+            0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34};
+
+        // the two lower case hex digits of each byte value
+        inline constexpr auto hex_digit_pairs = [] {
+            constexpr char digits[] = "0123456789abcdef";
+            std::array<std::array<char, 2>, 256> pairs{};
+            for (std::size_t value = 0; value < pairs.size(); value++) {
+                pairs[value] = {digits[value >> 4], digits[value & 0x0F]};
+            }
+            return pairs;
+        }();
+
+        /// <returns>the bytes of <paramref name="value"/> in the order they're written as text</returns>
+        constexpr std::array<std::uint8_t, 16> text_order_bytes(guid const& value) noexcept {
+            return {static_cast<std::uint8_t>(value.data1 >> 24), static_cast<std::uint8_t>(value.data1 >> 16),
+                static_cast<std::uint8_t>(value.data1 >> 8), static_cast<std::uint8_t>(value.data1),
+                static_cast<std::uint8_t>(value.data2 >> 8), static_cast<std::uint8_t>(value.data2),
+                static_cast<std::uint8_t>(value.data3 >> 8), static_cast<std::uint8_t>(value.data3), value.data4[0],
+                value.data4[1], value.data4[2], value.data4[3], value.data4[4], value.data4[5], value.data4[6],
+                value.data4[7]};
+        }
+
+        template <typename CharT>
+        constexpr std::uint8_t hex_digit_value(CharT const ch) noexcept {
+            auto const code = static_cast<std::make_unsigned_t<CharT>>(ch);
+            return code < hex_digit_values.size() ? hex_digit_values[code] : std::uint8_t{0xFF};
+        }
+
+        /// <remarks>
+        /// checks only the fixed length and dash positions before decoding, every digit is decoded through the
+        /// table and invalid digits are collected with a single OR so there's one branch for all 32 of them
+        /// </remarks>
+        template <typename CharT>
+        constexpr std::optional<guid> try_parse_guid(std::basic_string_view<CharT> text) noexcept {
+            if (text.size() == 38) {
+                if (text.front() != CharT{'{'} || text.back() != CharT{'}'}) {
+                    return std::nullopt;
+                }
+                text = text.substr(1, 36);
+            }
+            if (text.size() != 36 || text[8] != CharT{'-'} || text[13] != CharT{'-'} || text[18] != CharT{'-'} ||
+                text[23] != CharT{'-'}) {
+                return std::nullopt;
+            }
+
+            std::array<std::uint8_t, 16> bytes{};
+            std::uint8_t invalid = 0;
+            for (std::size_t i = 0; i < bytes.size(); i++) {
+                std::uint8_t const high = hex_digit_value(text[byte_offsets[i]]);
+                std::uint8_t const low  = hex_digit_value(text[byte_offsets[i] + 1]);
+                invalid |= static_cast<std::uint8_t>(high | low);
+                bytes[i] = static_cast<std::uint8_t>((high << 4) | (low & 0x0F));
+            }
+            if ((invalid & 0xF0) != 0) {
+                return std::nullopt;
+            }
+
+            guid result{};
+            result.data1 = static_cast<std::uint32_t>(bytes[0]) << 24 | static_cast<std::uint32_t>(bytes[1]) << 16 |
+                           static_cast<std::uint32_t>(bytes[2]) << 8 | bytes[3];
+            result.data2 = static_cast<std::uint16_t>(bytes[4] << 8 | bytes[5]);
+            result.data3 = static_cast<std::uint16_t>(bytes[6] << 8 | bytes[7]);
+            for (std::size_t i = 0; i < result.data4.size(); i++) {
+                result.data4[i] = bytes[8 + i];
+            }
+            return result;
+        }
+
+    } // namespace details
+
+    /// <summary>
+    /// parses the registry format of a GUID, <c>xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx</c>, optionally surrounded
+    /// by braces; hex digits may be either case
+    /// </summary>
+    /// <returns>the parsed value, or an empty optional if <paramref name="text"/> isn't a GUID</returns>
+    [[nodiscard]]
+    constexpr std::optional<guid> try_parse_guid(std::string_view const text) noexcept {
+        return details::try_parse_guid(text);
+    }
+
+    /// <inheritdoc cref="try_parse_guid(std::string_view)"/>
+    [[nodiscard]]
+    constexpr std::optional<guid> try_parse_guid(std::wstring_view const text) noexcept {
+        return details::try_parse_guid(text);
+    }
+
+    /// <summary>
+    /// parses the registry format of a GUID as <see cref="try_parse_guid"/>; in a constant expression an invalid
+    /// GUID fails to compile, so constant ids are checked and folded at compile time
+    /// </summary>
+    /// <exception cref="std::invalid_argument">if <paramref name="text"/> isn't a GUID</exception>
+    [[nodiscard]]
+    constexpr guid parse_guid(std::string_view const text) {
+        if (auto const result = try_parse_guid(text); result.has_value()) {
+            return *result;
+        }
+        throw std::invalid_argument("not a valid GUID");
+    }
+
+    /// <inheritdoc cref="parse_guid(std::string_view)"/>
+    [[nodiscard]]
+    constexpr guid parse_guid(std::wstring_view const text) {
+        if (auto const result = try_parse_guid(text); result.has_value()) {
+            return *result;
+        }
+        throw std::invalid_argument("not a valid GUID");
+    }
+
+    /// <summary>
+    /// number of characters written by <see cref="format_guid"/>
+    /// </summary>
+    inline constexpr std::size_t guid_string_length = 36;
+
+    /// <summary>
+    /// writes the registry format of <paramref name="value"/> without braces, in lower case as UuidToString
+    /// does, to <paramref name="output"/>; no terminator is written
+    /// </summary>
+    /// <remarks>
+    /// every byte is two characters copied from a table to a fixed offset, so there are no branches on the value
+    /// </remarks>
+    template <typename CharT>
+    constexpr void format_guid(guid const& value, std::span<CharT, guid_string_length> const output) noexcept {
+        std::array<std::uint8_t, 16> const bytes = details::text_order_bytes(value);
+        for (std::size_t i = 0; i < bytes.size(); i++) {
+            auto const& [high, low]              = details::hex_digit_pairs[bytes[i]];
+            output[details::byte_offsets[i]]     = static_cast<CharT>(high);
+            output[details::byte_offsets[i] + 1] = static_cast<CharT>(low);
+        }
+        output[8]  = CharT{'-'};
+        output[13] = CharT{'-'};
+        output[18] = CharT{'-'};
+        output[23] = CharT{'-'};
+    }
+
+    namespace literals {
+        /// <summary>
+        /// GUID constant checked at compile time, <c>"e3d3572d-9e25-4cf3-82f5-45b6f0035a82"_guid</c>
+        /// </summary>
+        consteval guid operator""_guid(char const* const text, std::size_t const length) {
+            return parse_guid(std::string_view{text, length});
+        }
+    } // namespace literals
+
+#ifdef _WIN32
+    [[nodiscard]]
+    constexpr GUID to_win32(guid const& value) noexcept {
+        return GUID{value.data1, value.data2, value.data3,
+            {value.data4[0], value.data4[1], value.data4[2], value.data4[3], value.data4[4], value.data4[5],
+                value.data4[6], value.data4[7]}};
+    }
+
+    [[nodiscard]]
+    constexpr guid from_win32(GUID const& value) noexcept {
+        return guid{value.Data1, value.Data2, value.Data3,
+            {value.Data4[0], value.Data4[1], value.Data4[2], value.Data4[3], value.Data4[4], value.Data4[5],
+                value.Data4[6], value.Data4[7]}};
+    }
+#endif
+
+} // namespace tsmoreland::interop
@@ -0,0 +1,121 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace tsmoreland::interop {
+
+    /// <summary>
+    /// summary of the durations recorded by a <see cref="latency_histogram"/>, in nanoseconds
+    /// </summary>
+    struct latency_summary {
+        std::uint64_t count;
+        double mean_ns;
+        std::uint64_t p50_ns;
+        std::uint64_t p99_ns;
+        std::uint64_t max_ns;
+    };
+
+    /// <summary>
+    /// lock free histogram of durations in power of two buckets, cheap enough to record every call on a hot path
+    /// </summary>
+    /// <remarks>
+    /// percentiles are reported as the upper bound of the bucket they fall in, so within a factor of 2
+    /// </remarks>
+    class latency_histogram final {
+    public:
+        static constexpr std::size_t bucket_count = 64;
+
+        void record(std::chrono::nanoseconds const duration) noexcept {
+            auto const ns = static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0));
+            buckets_[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+            total_ns_.fetch_add(ns, std::memory_order_relaxed);
+
+            std::uint64_t max = max_ns_.load(std::memory_order_relaxed);
+            while (ns > max && !max_ns_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+            }
+        }
+
+        /// <remarks>
+        /// read while durations are being recorded, the figures may come from slightly different moments
+        /// </remarks>
+        [[nodiscard]]
+        latency_summary summary() const noexcept {
+            std::array<std::uint64_t, bucket_count> counts{};
+            std::uint64_t count = 0;
+            for (std::size_t i = 0; i < bucket_count; i++) {
+                counts[i] = buckets_[i].load(std::memory_order_relaxed);
+                count += counts[i];
+            }
+            if (count == 0) {
+                return {};
+            }
+
+            return {
+                count,
+                static_cast<double>(total_ns_.load(std::memory_order_relaxed)) / static_cast<double>(count),
+                percentile(counts, count, 50),
+                percentile(counts, count, 99),
+                max_ns_.load(std::memory_order_relaxed),
+            };
+        }
+
+        /// <returns>the bucket holding durations of <paramref name="ns"/>, bucket i holds [2^(i-1), 2^i)</returns>
+        [[nodiscard]]
+        static constexpr std::size_t bucket_of(std::uint64_t const ns) noexcept {
+            return std::min<std::size_t>(static_cast<std::size_t>(std::bit_width(ns)), bucket_count - 1);
+        }
+
+        /// <returns>the largest duration held by <paramref name="bucket"/></returns>
+        [[nodiscard]]
+        static constexpr std::uint64_t bucket_upper_bound(std::size_t const bucket) noexcept {
+            if (bucket >= bucket_count - 1) {
+                return std::numeric_limits<std::uint64_t>::max();
+            }
+            return (std::uint64_t{1} << bucket) - 1;
+        }
+
+    private:
+        [[nodiscard]]
+        static std::uint64_t percentile(std::array<std::uint64_t, bucket_count> const& counts,
+            std::uint64_t const count, std::uint64_t const percent) noexcept {
+            // the smallest bucket at or below which percent of the durations fall
+            std::uint64_t const rank = (count * percent + 99) / 100;
+            std::uint64_t seen       = 0;
+            for (std::size_t i = 0; i < bucket_count; i++) {
+                seen += counts[i];
+                if (seen >= rank) {
+                    return bucket_upper_bound(i);
+                }
+            }
+            return bucket_upper_bound(bucket_count - 1);
+        }
+
+        std::array<std::atomic<std::uint64_t>, bucket_count> buckets_{};
+        std::atomic<std::uint64_t> total_ns_{0};
+        std::atomic<std::uint64_t> max_ns_{0};
+    };
+
+} // namespace tsmoreland::interop
@@ -0,0 +1,138 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace tsmoreland::interop {
+
+    /// <summary>
+    /// counters of an <see cref="object_pool"/>
+    /// </summary>
+    struct object_pool_statistics {
+        std::size_t capacity;
+        std::size_t idle;
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t returned;
+        std::uint64_t discarded;
+    };
+
+    /// <summary>
+    /// bounded set of idle objects waiting to be reused, most recently returned first so the object handed out is
+    /// the one most likely to still be in cache
+    /// </summary>
+    /// <remarks>
+    /// holds pointers only: the caller creates and resets the objects, and destroys those the pool has no room for
+    /// and those <see cref="drain"/> returns
+    /// </remarks>
+    template <typename T>
+    class object_pool final {
+    public:
+        /// <param name="capacity">most idle objects held, 0 disables pooling</param>
+        explicit object_pool(std::size_t const capacity = 0) : capacity_{capacity} {
+            idle_.reserve(capacity);
+        }
+
+        object_pool(object_pool const&)            = delete;
+        object_pool& operator=(object_pool const&) = delete;
+
+        /// <summary>
+        /// changes the most idle objects held, objects beyond the new capacity are returned for the caller to
+        /// destroy
+        /// </summary>
+        /// <exception cref="std::bad_alloc">
+        /// if room for <paramref name="capacity"/> objects can't be reserved, the pool is unchanged
+        /// </exception>
+        [[nodiscard]]
+        std::vector<T*> set_capacity(std::size_t const capacity) {
+            std::scoped_lock const guard{lock_};
+            idle_.reserve(capacity);
+            capacity_ = capacity;
+
+            std::vector<T*> excess;
+            while (idle_.size() > capacity_) {
+                excess.push_back(idle_.back());
+                idle_.pop_back();
+            }
+            return excess;
+        }
+
+        /// <returns>the most recently returned idle object, or nullptr if there are none</returns>
+        [[nodiscard]]
+        T* try_acquire() noexcept {
+            std::scoped_lock const guard{lock_};
+            if (idle_.empty()) {
+                statistics_.misses++;
+                return nullptr;
+            }
+            statistics_.hits++;
+            T* const object = idle_.back();
+            idle_.pop_back();
+            return object;
+        }
+
+        /// <summary>
+        /// holds <paramref name="object"/>, already reset, until it is acquired again
+        /// </summary>
+        /// <returns>true if it was held, false if the pool is full and the caller must destroy it</returns>
+        [[nodiscard]]
+        bool try_return(T* const object) noexcept {
+            std::scoped_lock const guard{lock_};
+            if (idle_.size() >= capacity_) {
+                statistics_.discarded++;
+                return false;
+            }
+            // never reallocates, capacity_ elements were reserved
+            idle_.push_back(object);
+            statistics_.returned++;
+            return true;
+        }
+
+        /// <summary>
+        /// disables pooling, objects returned later are discarded until <see cref="set_capacity"/> is called
+        /// </summary>
+        /// <returns>every idle object, for the caller to destroy</returns>
+        [[nodiscard]]
+        std::vector<T*> drain() noexcept {
+            std::scoped_lock const guard{lock_};
+            std::vector<T*> drained;
+            drained.swap(idle_);
+            capacity_ = 0;
+            return drained;
+        }
+
+        [[nodiscard]]
+        object_pool_statistics statistics() const noexcept {
+            std::scoped_lock const guard{lock_};
+            object_pool_statistics statistics = statistics_;
+            statistics.capacity               = capacity_;
+            statistics.idle                   = idle_.size();
+            return statistics;
+        }
+
+    private:
+        mutable std::mutex lock_;
+        std::size_t capacity_;
+        std::vector<T*> idle_;
+        object_pool_statistics statistics_{};
+    };
+
+} // namespace tsmoreland::interop
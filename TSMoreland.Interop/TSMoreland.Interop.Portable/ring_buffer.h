@@ -0,0 +1,325 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace tsmoreland::interop {
+
+    namespace details {
+        // fixed rather than std::hardware_destructive_interference_size, the layout is shared between processes
+        inline constexpr std::size_t ring_alignment = 64;
+
+        inline constexpr std::uint32_t ring_magic = 0x52'49'4E'47; // "RING"
+
+        struct ring_header {
+            std::uint32_t magic;
+            std::uint32_t slot_count;
+            std::uint32_t slot_size;
+            alignas(ring_alignment) std::atomic<std::uint64_t> head;
+            alignas(ring_alignment) std::atomic<std::uint64_t> tail;
+        };
+
+        struct ring_slot {
+            std::atomic<std::uint64_t> sequence;
+            std::uint32_t length;
+        };
+
+        // the atomics must work between processes mapping the same memory at different addresses
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+        static_assert(sizeof(ring_header) % ring_alignment == 0);
+
+        [[nodiscard]]
+        constexpr std::size_t ring_slot_stride(std::size_t const slot_size) noexcept {
+            return (sizeof(ring_slot) + slot_size + ring_alignment - 1) / ring_alignment * ring_alignment;
+        }
+    } // namespace details
+
+    /// <summary>
+    /// bounded queue of messages of up to slot_size bytes laid out in caller supplied memory, such as a shared
+    /// memory region, so it can be written in one process and read in another without copying through a kernel
+    /// </summary>
+    /// <remarks>
+    /// lock free for any number of writers and readers: each slot carries a sequence number that says whether it
+    /// is free to write or ready to read for the current lap, and a writer or reader claims its slot with a single
+    /// compare exchange of the head or tail.  The memory is not owned; it must outlive the ring and be aligned
+    /// to 64 bytes, as a page from a mapping is
+    /// </remarks>
+    class ring_buffer final {
+    public:
+        /// <returns>the bytes needed for a ring of <paramref name="slot_count"/> messages of
+        /// <paramref name="slot_size"/> bytes, a multiple of 64</returns>
+        [[nodiscard]]
+        static constexpr std::size_t required_size(
+            std::uint32_t const slot_count, std::uint32_t const slot_size) noexcept {
+            return sizeof(details::ring_header) + slot_count * details::ring_slot_stride(slot_size);
+        }
+
+        /// <summary>
+        /// lays out an empty ring at the start of <paramref name="memory"/>
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// if <paramref name="slot_count"/> isn't a power of 2 of at least 2, <paramref name="slot_size"/> is 0, or
+        /// <paramref name="memory"/> is too small or misaligned
+        /// </exception>
+        [[nodiscard]]
+        static ring_buffer create(std::span<std::byte> const memory, std::uint32_t const slot_count,
+            std::uint32_t const slot_size) {
+            if (slot_count < 2 || !std::has_single_bit(slot_count)) {
+                throw std::invalid_argument("slot count must be a power of 2 of at least 2");
+            }
+            if (slot_size == 0) {
+                throw std::invalid_argument("slot size must be greater than 0");
+            }
+            check_memory(memory, slot_count, slot_size);
+
+            auto* const header = std::construct_at(reinterpret_cast<details::ring_header*>(memory.data()));
+            header->slot_count = slot_count;
+            header->slot_size  = slot_size;
+            ring_buffer ring{memory.data(), slot_count, slot_size};
+            for (std::uint32_t i = 0; i < slot_count; i++) {
+                std::construct_at(&ring.slot_at(i), i, 0U);
+            }
+            // publishes the header last so a reader attaching early sees no ring rather than half of one
+            std::atomic_ref{header->magic}.store(details::ring_magic, std::memory_order_release);
+            return ring;
+        }
+
+        /// <summary>
+        /// uses the ring another process, or another mapping, created at the start of <paramref name="memory"/>
+        /// </summary>
+        /// <exception cref="std::invalid_argument">
+        /// if <paramref name="memory"/> doesn't hold a ring, or is too small or misaligned for the one it holds
+        /// </exception>
+        [[nodiscard]]
+        static ring_buffer attach(std::span<std::byte> const memory) {
+            if (memory.size() < sizeof(details::ring_header) ||
+                reinterpret_cast<std::uintptr_t>(memory.data()) % details::ring_alignment != 0) {
+                throw std::invalid_argument("memory doesn't hold a ring");
+            }
+            auto* const header = std::launder(reinterpret_cast<details::ring_header*>(memory.data()));
+            if (std::atomic_ref{header->magic}.load(std::memory_order_acquire) != details::ring_magic) {
+                throw std::invalid_argument("memory doesn't hold a ring");
+            }
+
+            // copied once, the ring never trusts a later change to the shared header
+            std::uint32_t const slot_count = header->slot_count;
+            std::uint32_t const slot_size  = header->slot_size;
+            if (slot_count < 2 || !std::has_single_bit(slot_count) || slot_size == 0) {
+                throw std::invalid_argument("memory doesn't hold a ring");
+            }
+            check_memory(memory, slot_count, slot_size);
+            return ring_buffer{memory.data(), slot_count, slot_size};
+        }
+
+        /// <summary>
+        /// claims a slot, lets <paramref name="fill"/> write <paramref name="length"/> bytes into it and publishes
+        /// it to readers
+        /// </summary>
+        /// <param name="length">bytes in the message, at most <see cref="slot_size"/></param>
+        /// <param name="fill">called with the slot's payload, can't throw as the slot is already claimed</param>
+        /// <returns>true if the message was written, false if the ring is full</returns>
+        /// <exception cref="std::invalid_argument">if <paramref name="length"/> is larger than a slot</exception>
+        template <typename Fill>
+            requires std::is_nothrow_invocable_v<Fill&, std::span<std::byte>>
+        bool try_write(std::size_t const length, Fill&& fill) {
+            if (length > slot_size_) {
+                throw std::invalid_argument("message is larger than a slot");
+            }
+
+            std::uint64_t position = header_->head.load(std::memory_order_relaxed);
+            details::ring_slot* slot;
+            for (;;) {
+                slot                         = &slot_at(position);
+                std::uint64_t const sequence = slot->sequence.load(std::memory_order_acquire);
+                auto const lap               = static_cast<std::int64_t>(sequence - position);
+                if (lap == 0) {
+                    if (header_->head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (lap < 0) {
+                    return false;
+                } else {
+                    position = header_->head.load(std::memory_order_relaxed);
+                }
+            }
+
+            fill(std::span{payload_of(*slot), length});
+            slot->length = static_cast<std::uint32_t>(length);
+            slot->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// <summary>
+        /// copies <paramref name="message"/> into the ring
+        /// </summary>
+        /// <returns>true if the message was written, false if the ring is full</returns>
+        /// <exception cref="std::invalid_argument">if <paramref name="message"/> is larger than a slot</exception>
+        bool try_write(std::span<std::byte const> const message) {
+            return try_write(message.size(), [message](std::span<std::byte> const payload) noexcept {
+                std::memcpy(payload.data(), message.data(), message.size());
+            });
+        }
+
+        /// <summary>
+        /// takes the oldest message and passes it to <paramref name="consume"/>, the slot is reused once it returns
+        /// </summary>
+        /// <param name="consume">called with the message, can't throw as the slot is already claimed</param>
+        /// <returns>true if a message was read, false if the ring is empty</returns>
+        template <typename Consume>
+            requires std::is_nothrow_invocable_v<Consume&, std::span<std::byte const>>
+        bool try_read(Consume&& consume) noexcept {
+            std::uint64_t position = header_->tail.load(std::memory_order_relaxed);
+            details::ring_slot* slot;
+            for (;;) {
+                slot                         = &slot_at(position);
+                std::uint64_t const sequence = slot->sequence.load(std::memory_order_acquire);
+                auto const lap               = static_cast<std::int64_t>(sequence - (position + 1));
+                if (lap == 0) {
+                    if (header_->tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (lap < 0) {
+                    return false;
+                } else {
+                    position = header_->tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            // the length is in memory the other process can write, it's never trusted past the slot
+            std::size_t const length = std::min<std::size_t>(slot->length, slot_size_);
+            consume(std::span<std::byte const>{payload_of(*slot), length});
+            slot->sequence.store(position + slot_count_, std::memory_order_release);
+            return true;
+        }
+
+        /// <returns>
+        /// true if the next write would fail; only certain while no other thread is writing
+        /// </returns>
+        [[nodiscard]]
+        bool full() const noexcept {
+            std::uint64_t const position = header_->head.load(std::memory_order_relaxed);
+            return slot_at(position).sequence.load(std::memory_order_acquire) != position;
+        }
+
+        /// <returns>
+        /// true if the next read would fail; only certain while no other thread is reading
+        /// </returns>
+        [[nodiscard]]
+        bool empty() const noexcept {
+            std::uint64_t const position = header_->tail.load(std::memory_order_relaxed);
+            return slot_at(position).sequence.load(std::memory_order_acquire) != position + 1;
+        }
+
+        [[nodiscard]]
+        std::uint32_t slot_count() const noexcept {
+            return slot_count_;
+        }
+
+        /// <returns>the largest message the ring holds, in bytes</returns>
+        [[nodiscard]]
+        std::uint32_t slot_size() const noexcept {
+            return slot_size_;
+        }
+
+        /// <returns>the bytes of memory the ring occupies, see <see cref="required_size"/></returns>
+        [[nodiscard]]
+        std::size_t size_bytes() const noexcept {
+            return required_size(slot_count_, slot_size_);
+        }
+
+    private:
+        ring_buffer(std::byte* const memory, std::uint32_t const slot_count, std::uint32_t const slot_size) noexcept
+            : header_{std::launder(reinterpret_cast<details::ring_header*>(memory))}
+            , slots_{memory + sizeof(details::ring_header)}
+            , slot_count_{slot_count}
+            , slot_size_{slot_size}
+            , stride_{details::ring_slot_stride(slot_size)} {}
+
+        static void check_memory(
+            std::span<std::byte> const memory, std::uint32_t const slot_count, std::uint32_t const slot_size) {
+            if (reinterpret_cast<std::uintptr_t>(memory.data()) % details::ring_alignment != 0) {
+                throw std::invalid_argument("memory must be aligned to 64 bytes");
+            }
+            if (memory.size() < required_size(slot_count, slot_size)) {
+                throw std::invalid_argument("memory is too small for the ring");
+            }
+        }
+
+        [[nodiscard]]
+        details::ring_slot& slot_at(std::uint64_t const position) const noexcept {
+            std::size_t const index = static_cast<std::size_t>(position) & (slot_count_ - 1);
+            return *std::launder(reinterpret_cast<details::ring_slot*>(slots_ + index * stride_));
+        }
+
+        [[nodiscard]]
+        static std::byte* payload_of(details::ring_slot& slot) noexcept {
+            return reinterpret_cast<std::byte*>(&slot) + sizeof(details::ring_slot);
+        }
+
+        details::ring_header* header_;
+        std::byte* slots_;
+        std::uint32_t slot_count_;
+        std::uint32_t slot_size_;
+        std::size_t stride_;
+    };
+
+    /// <summary>
+    /// a pair of rings in one block of memory, requests from a client followed by responses from a server
+    /// </summary>
+    struct ring_channel {
+        ring_buffer requests;
+        ring_buffer responses;
+
+        /// <returns>the bytes needed for both rings, each as <see cref="ring_buffer::required_size"/></returns>
+        [[nodiscard]]
+        static constexpr std::size_t required_size(
+            std::uint32_t const slot_count, std::uint32_t const slot_size) noexcept {
+            return 2 * ring_buffer::required_size(slot_count, slot_size);
+        }
+
+        /// <exception cref="std::invalid_argument">as <see cref="ring_buffer::create"/></exception>
+        [[nodiscard]]
+        static ring_channel create(std::span<std::byte> const memory, std::uint32_t const slot_count,
+            std::uint32_t const slot_size) {
+            std::size_t const ring_size = ring_buffer::required_size(slot_count, slot_size);
+            if (memory.size() < 2 * ring_size) {
+                throw std::invalid_argument("memory is too small for the channel");
+            }
+            return {ring_buffer::create(memory.first(ring_size), slot_count, slot_size),
+                ring_buffer::create(memory.subspan(ring_size), slot_count, slot_size)};
+        }
+
+        /// <exception cref="std::invalid_argument">as <see cref="ring_buffer::attach"/></exception>
+        [[nodiscard]]
+        static ring_channel attach(std::span<std::byte> const memory) {
+            ring_buffer requests = ring_buffer::attach(memory);
+            std::size_t const ring_size = requests.size_bytes();
+            return {requests, ring_buffer::attach(memory.subspan(ring_size))};
+        }
+    };
+
+} // namespace tsmoreland::interop
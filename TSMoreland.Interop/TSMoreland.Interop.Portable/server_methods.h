@@ -0,0 +1,237 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+#ifdef _WIN32
+#include <atlbase.h>
+#include <atlsafe.h>
+#endif
+
+#include "case_conversion.h"
+#include "string_allocator.h"
+
+namespace tsmoreland::interop {
+
+#ifdef _WIN32
+    template <typename Method>
+    using bstr_allocator = string_allocator<bstr_traits, Method>;
+
+    /// <summary>
+    /// the properties of a SimpleObject which never change
+    /// </summary>
+    struct immutable_properties {
+        std::wstring_view name;
+        GUID id;
+        std::wstring_view description;
+    };
+
+    /// <summary>
+    /// stores a new copy of <paramref name="text"/> in <paramref name="result"/>, counted against
+    /// <paramref name="method"/>
+    /// </summary>
+    template <typename Method>
+    HRESULT copy_bstr(
+        bstr_allocator<Method>& strings, Method const method, std::wstring_view const text, BSTR* result) noexcept {
+        BSTR const copy = strings.allocate(method, text);
+        if (copy == nullptr) {
+            return E_OUTOFMEMORY;
+        }
+
+        *result = copy;
+        return S_OK;
+    }
+
+    /// <summary>
+    /// the length prefix is used rather than the terminator so embedded nulls are kept, and the result is written
+    /// once straight into its BSTR; a null BSTR is an empty string
+    /// </summary>
+    template <typename Method>
+    HRESULT upper_case_bstr(
+        bstr_allocator<Method>& strings, Method const method, BSTR const input, BSTR* result) noexcept {
+        UINT const length = ::SysStringLen(input);
+        BSTR const upper  = strings.allocate(method, length);
+        if (upper == nullptr) {
+            return E_OUTOFMEMORY;
+        }
+        to_upper(std::wstring_view{input, length}, std::span{upper, length});
+
+        *result = upper;
+        return S_OK;
+    }
+
+    /// <summary>
+    /// converts each element of the one dimensional array <paramref name="inputs"/> to a BSTR, storing them in
+    /// a new array with the same bounds
+    /// </summary>
+    /// <returns>
+    /// S_OK on success; E_INVALIDARG if either array pointer is a nullptr or <paramref name="inputs"/> isn't one
+    /// dimensional with elements of <paramref name="type"/> and size of <typeparamref name="Element"/>; otherwise
+    /// the first failure, in which case no array is returned
+    /// </returns>
+    template <typename Element, typename Convert>
+    HRESULT convert_each(
+        SAFEARRAY* inputs, VARTYPE const type, SAFEARRAY** results, Convert const& convert) noexcept {
+        VARTYPE actual_type{VT_EMPTY};
+        if (inputs == nullptr || results == nullptr || ::SafeArrayGetDim(inputs) != 1 ||
+            FAILED(::SafeArrayGetVartype(inputs, &actual_type)) || actual_type != type ||
+            ::SafeArrayGetElemsize(inputs) != sizeof(Element)) {
+            return E_INVALIDARG;
+        }
+
+        LONG lower_bound{};
+        LONG upper_bound{};
+        if (HRESULT const hr = ::SafeArrayGetLBound(inputs, 1, &lower_bound); FAILED(hr)) {
+            return hr;
+        }
+        if (HRESULT const hr = ::SafeArrayGetUBound(inputs, 1, &upper_bound); FAILED(hr)) {
+            return hr;
+        }
+        auto const count = static_cast<ULONG>(upper_bound - lower_bound + 1);
+
+        // destroying the array frees any strings already converted if a later one fails
+        ATL::CComSafeArray<BSTR> converted;
+        if (HRESULT const hr = converted.Create(count, lower_bound); FAILED(hr)) {
+            return hr;
+        }
+
+        Element* source{};
+        if (HRESULT const hr = ::SafeArrayAccessData(inputs, reinterpret_cast<void**>(&source)); FAILED(hr)) {
+            return hr;
+        }
+        BSTR* target{};
+        HRESULT hr = ::SafeArrayAccessData(converted.m_psa, reinterpret_cast<void**>(&target));
+        for (ULONG i = 0; SUCCEEDED(hr) && i < count; i++) {
+            hr = convert(source[i], &target[i]);
+        }
+        if (target != nullptr) {
+            ::SafeArrayUnaccessData(converted.m_psa);
+        }
+        ::SafeArrayUnaccessData(inputs);
+        if (FAILED(hr)) {
+            return hr;
+        }
+
+        *results = converted.Detach();
+        return S_OK;
+    }
+
+    /// <summary>
+    /// the name of each method in <paramref name="names"/>, in the order of <typeparamref name="Method"/>, with
+    /// the strings it has allocated and their size in bytes, as GetStringStatistics returns them
+    /// </summary>
+    /// <returns>
+    /// S_OK on success; E_INVALIDARG if any array pointer is a nullptr, otherwise the failure from creating the
+    /// arrays in which case none are returned
+    /// </returns>
+    template <typename Method, std::size_t Count>
+    HRESULT string_statistics(bstr_allocator<Method> const& strings, std::array<std::wstring_view, Count> const& names,
+        SAFEARRAY** methods, SAFEARRAY** allocations, SAFEARRAY** bytes) noexcept {
+        static_assert(Count == static_cast<std::size_t>(Method::count), "every method must have a name");
+        if (methods == nullptr || allocations == nullptr || bytes == nullptr) {
+            return E_INVALIDARG;
+        }
+
+        constexpr auto count = static_cast<ULONG>(Count);
+        ATL::CComSafeArray<BSTR> method_names;
+        ATL::CComSafeArray<LONGLONG> allocation_counts;
+        ATL::CComSafeArray<LONGLONG> byte_counts;
+        if (HRESULT const hr = method_names.Create(count); FAILED(hr)) {
+            return hr;
+        }
+        if (HRESULT const hr = allocation_counts.Create(count); FAILED(hr)) {
+            return hr;
+        }
+        if (HRESULT const hr = byte_counts.Create(count); FAILED(hr)) {
+            return hr;
+        }
+
+        for (ULONG i = 0; i < count; i++) {
+            auto const index = static_cast<LONG>(i);
+            auto const name  = names[i];
+            BSTR const text  = ::SysAllocStringLen(name.data(), static_cast<UINT>(name.size()));
+            if (text == nullptr) {
+                return E_OUTOFMEMORY;
+            }
+            // not copied, the array takes ownership of text
+            if (HRESULT const hr = method_names.SetAt(index, text, FALSE); FAILED(hr)) {
+                return hr;
+            }
+
+            auto const statistics = strings.statistics(static_cast<Method>(i));
+            allocation_counts.SetAt(index, static_cast<LONGLONG>(statistics.allocations));
+            byte_counts.SetAt(index, static_cast<LONGLONG>(statistics.bytes));
+        }
+
+        *methods     = method_names.Detach();
+        *allocations = allocation_counts.Detach();
+        *bytes       = byte_counts.Detach();
+        return S_OK;
+    }
+
+    /// <summary>
+    /// fills <paramref name="state"/> with every property, as GetState returns them, unless
+    /// <paramref name="version"/> still equals <paramref name="known_version"/> in which case only its Version is
+    /// set
+    /// </summary>
+    /// <typeparam name="State">the state UDT of either server, their Id fields share the layout of GUID</typeparam>
+    /// <returns>
+    /// S_OK on success; E_INVALIDARG if either pointer is a nullptr, or E_OUTOFMEMORY if the strings can't be
+    /// allocated
+    /// </returns>
+    template <typename State, typename Method>
+    HRESULT read_state(bstr_allocator<Method>& strings, Method const method, immutable_properties const& properties,
+        std::atomic<LONGLONG> const& version, std::atomic<LONG> const& numeric, LONGLONG const known_version,
+        State* state, VARIANT_BOOL* changed) noexcept {
+        if (state == nullptr || changed == nullptr) {
+            return E_INVALIDARG;
+        }
+
+        *state                 = State{};
+        LONGLONG const current = version.load(std::memory_order_acquire);
+        state->Version         = current;
+        if (current == known_version) {
+            *changed = VARIANT_FALSE;
+            return S_OK;
+        }
+
+        ATL::CComBSTR name;
+        ATL::CComBSTR description;
+        if (HRESULT const hr = copy_bstr(strings, method, properties.name, &name); FAILED(hr)) {
+            return hr;
+        }
+        if (HRESULT const hr = copy_bstr(strings, method, properties.description, &description); FAILED(hr)) {
+            return hr;
+        }
+
+        // read after the version, every change counted by it has already been stored
+        state->Numeric     = numeric.load(std::memory_order_acquire);
+        state->Name        = name.Detach();
+        state->Id          = std::bit_cast<decltype(state->Id)>(properties.id);
+        state->Description = description.Detach();
+        *changed           = VARIANT_TRUE;
+        return S_OK;
+    }
+#endif
+
+} // namespace tsmoreland::interop
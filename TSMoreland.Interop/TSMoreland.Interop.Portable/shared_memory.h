@@ -0,0 +1,232 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tsmoreland::interop {
+
+    /// <summary>
+    /// a named block of memory mapped into this process, which other processes can map by name: a file mapping
+    /// backed by the paging file on Windows, a POSIX shared memory object elsewhere
+    /// </summary>
+    /// <remarks>
+    /// the memory starts zeroed and page aligned.  On Windows it's removed when the last mapping closes; elsewhere
+    /// the name is removed when the creator closes it and the memory when the last mapping closes
+    /// </remarks>
+    class shared_memory final {
+    public:
+#ifdef _WIN32
+        using name_type = std::wstring;
+#else
+        using name_type = std::string;
+#endif
+
+        shared_memory(shared_memory const&)            = delete;
+        shared_memory& operator=(shared_memory const&) = delete;
+
+        shared_memory(shared_memory&& other) noexcept
+            : name_{std::move(other.name_)}
+            , bytes_{std::exchange(other.bytes_, {})}
+            , owner_{std::exchange(other.owner_, false)}
+#ifdef _WIN32
+            , mapping_{std::exchange(other.mapping_, nullptr)}
+#endif
+        {
+        }
+
+        shared_memory& operator=(shared_memory&& other) noexcept {
+            if (this != &other) {
+                close();
+                name_  = std::move(other.name_);
+                bytes_ = std::exchange(other.bytes_, {});
+                owner_ = std::exchange(other.owner_, false);
+#ifdef _WIN32
+                mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+            }
+            return *this;
+        }
+
+        ~shared_memory() {
+            close();
+        }
+
+        /// <summary>
+        /// creates and maps a new block of <paramref name="size"/> bytes
+        /// </summary>
+        /// <param name="name">
+        /// name other processes open the block by, such as Local\name on Windows or /name elsewhere
+        /// </param>
+        /// <exception cref="std::system_error">
+        /// if the name is in use or the block can't be created or mapped
+        /// </exception>
+        [[nodiscard]]
+        static shared_memory create(name_type name, std::size_t const size) {
+            shared_memory memory{std::move(name), true};
+#ifdef _WIN32
+            auto const large = static_cast<unsigned long long>(size);
+            memory.mapping_  = ::CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                 static_cast<DWORD>(large >> 32), static_cast<DWORD>(large), memory.name_.c_str());
+            if (memory.mapping_ == nullptr) {
+                throw_last_error("CreateFileMapping");
+            }
+            if (::GetLastError() == ERROR_ALREADY_EXISTS) {
+                throw std::system_error(ERROR_ALREADY_EXISTS, std::system_category(), "CreateFileMapping");
+            }
+            memory.map(size);
+#else
+            int const descriptor = ::shm_open(memory.name_.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+            if (descriptor == -1) {
+                memory.owner_ = false;
+                throw_last_error("shm_open");
+            }
+            if (::ftruncate(descriptor, static_cast<off_t>(size)) == -1) {
+                int const error = errno;
+                ::close(descriptor);
+                throw std::system_error(error, std::system_category(), "ftruncate");
+            }
+            memory.map(descriptor, size);
+#endif
+            return memory;
+        }
+
+        /// <summary>
+        /// maps the whole of an existing block
+        /// </summary>
+        /// <exception cref="std::system_error">
+        /// if there's no block named <paramref name="name"/> or it can't be mapped
+        /// </exception>
+        [[nodiscard]]
+        static shared_memory open(name_type name) {
+            shared_memory memory{std::move(name), false};
+#ifdef _WIN32
+            memory.mapping_ = ::OpenFileMappingW(FILE_MAP_READ | FILE_MAP_WRITE, FALSE, memory.name_.c_str());
+            if (memory.mapping_ == nullptr) {
+                throw_last_error("OpenFileMapping");
+            }
+            memory.map(0);
+#else
+            int const descriptor = ::shm_open(memory.name_.c_str(), O_RDWR, 0);
+            if (descriptor == -1) {
+                throw_last_error("shm_open");
+            }
+            struct stat status{};
+            if (::fstat(descriptor, &status) == -1) {
+                int const error = errno;
+                ::close(descriptor);
+                throw std::system_error(error, std::system_category(), "fstat");
+            }
+            memory.map(descriptor, static_cast<std::size_t>(status.st_size));
+#endif
+            return memory;
+        }
+
+        [[nodiscard]]
+        std::span<std::byte> bytes() const noexcept {
+            return bytes_;
+        }
+
+        [[nodiscard]]
+        name_type const& name() const noexcept {
+            return name_;
+        }
+
+    private:
+        shared_memory(name_type name, bool const owner) noexcept : name_{std::move(name)}, owner_{owner} {}
+
+        [[noreturn]]
+        static void throw_last_error(char const* const operation) {
+#ifdef _WIN32
+            throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(), operation);
+#else
+            throw std::system_error(errno, std::system_category(), operation);
+#endif
+        }
+
+#ifdef _WIN32
+        /// <param name="size">bytes to map, 0 for the whole block</param>
+        void map(std::size_t const size) {
+            void* const view = ::MapViewOfFile(mapping_, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, size);
+            if (view == nullptr) {
+                throw_last_error("MapViewOfFile");
+            }
+
+            MEMORY_BASIC_INFORMATION information{};
+            ::VirtualQuery(view, &information, sizeof(information));
+            bytes_ = {static_cast<std::byte*>(view), size != 0 ? size : information.RegionSize};
+        }
+#else
+        /// <summary>
+        /// maps <paramref name="size"/> bytes of <paramref name="descriptor"/> and closes it, the mapping keeps
+        /// the block open
+        /// </summary>
+        void map(int const descriptor, std::size_t const size) {
+            void* const view = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+            int const error  = errno;
+            ::close(descriptor);
+            if (view == MAP_FAILED) {
+                throw std::system_error(error, std::system_category(), "mmap");
+            }
+            bytes_ = {static_cast<std::byte*>(view), size};
+        }
+#endif
+
+        void close() noexcept {
+#ifdef _WIN32
+            if (bytes_.data() != nullptr) {
+                ::UnmapViewOfFile(bytes_.data());
+            }
+            if (mapping_ != nullptr) {
+                ::CloseHandle(mapping_);
+            }
+            mapping_ = nullptr;
+#else
+            if (bytes_.data() != nullptr) {
+                ::munmap(bytes_.data(), bytes_.size());
+            }
+            if (owner_) {
+                ::shm_unlink(name_.c_str());
+            }
+#endif
+            bytes_ = {};
+            owner_ = false;
+        }
+
+        name_type name_;
+        std::span<std::byte> bytes_;
+        bool owner_;
+#ifdef _WIN32
+        HANDLE mapping_{};
+#endif
+    };
+
+} // namespace tsmoreland::interop
@@ -0,0 +1,131 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace tsmoreland::interop {
+
+    /// <summary>
+    /// the sinks of a connection point held as an immutable, atomically replaced snapshot so events can be fired
+    /// without taking a lock; advise and unadvise copy the current snapshot, modify the copy and publish it
+    /// </summary>
+    /// <remarks>
+    /// a fire that loaded a snapshot before an unadvise completes may still call the removed sink, as a fire that
+    /// copied a sink pointer before the unadvise would
+    /// </remarks>
+    template <typename Sink>
+    class sink_snapshot final {
+    public:
+        using cookie_type = std::uint32_t;
+
+        struct connection {
+            cookie_type cookie;
+            Sink sink;
+        };
+
+        using snapshot_type = std::shared_ptr<std::vector<connection> const>;
+
+        sink_snapshot() : empty_{std::make_shared<std::vector<connection> const>()}, current_{empty_} {}
+
+        sink_snapshot(sink_snapshot const&)            = delete;
+        sink_snapshot& operator=(sink_snapshot const&) = delete;
+
+        /// <summary>
+        /// adds <paramref name="sink"/> under <paramref name="cookie"/>, which must not already be connected
+        /// </summary>
+        /// <exception cref="std::bad_alloc">
+        /// if the new snapshot can't be allocated, the current snapshot is unchanged
+        /// </exception>
+        void add(cookie_type const cookie, Sink sink) {
+            std::scoped_lock const guard{writer_lock_};
+            auto const current = current_.load(std::memory_order_acquire);
+
+            auto next = std::make_shared<std::vector<connection>>();
+            next->reserve(current->size() + 1);
+            next->assign(current->begin(), current->end());
+            next->push_back(connection{cookie, std::move(sink)});
+            current_.store(std::move(next), std::memory_order_release);
+        }
+
+        /// <summary>
+        /// removes the sink connected under <paramref name="cookie"/>
+        /// </summary>
+        /// <returns>true if a sink was removed; otherwise false</returns>
+        /// <exception cref="std::bad_alloc">
+        /// if the new snapshot can't be allocated, the current snapshot is unchanged
+        /// </exception>
+        bool remove(cookie_type const cookie) {
+            std::scoped_lock const guard{writer_lock_};
+            auto const current = current_.load(std::memory_order_acquire);
+
+            auto const matches = [cookie](connection const& entry) { return entry.cookie == cookie; };
+            if (std::ranges::none_of(*current, matches)) {
+                return false;
+            }
+
+            auto next = std::make_shared<std::vector<connection>>();
+            next->reserve(current->size() - 1);
+            std::ranges::copy_if(*current, std::back_inserter(*next), std::not_fn(matches));
+            current_.store(std::move(next), std::memory_order_release);
+            return true;
+        }
+
+        /// <summary>
+        /// removes every sink
+        /// </summary>
+        void clear() noexcept {
+            std::scoped_lock const guard{writer_lock_};
+            current_.store(empty_, std::memory_order_release);
+        }
+
+        /// <returns>
+        /// the sinks connected at the time of the call, unaffected by later calls to <see cref="add"/> or
+        /// <see cref="remove"/>
+        /// </returns>
+        [[nodiscard]]
+        snapshot_type snapshot() const noexcept {
+            return current_.load(std::memory_order_acquire);
+        }
+
+        /// <summary>
+        /// calls <paramref name="func"/> with each sink of the current snapshot
+        /// </summary>
+        template <typename Func>
+        void for_each(Func&& func) const {
+            auto const sinks = snapshot();
+            for (auto const& [cookie, sink] : *sinks) {
+                func(sink);
+            }
+        }
+
+    private:
+        // allocated once so clearing can't fail
+        snapshot_type empty_;
+        std::atomic<snapshot_type> current_;
+        std::mutex writer_lock_;
+    };
+
+} // namespace tsmoreland::interop
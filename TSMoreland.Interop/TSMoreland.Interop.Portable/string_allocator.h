@@ -0,0 +1,197 @@
+//
+// Copyright �2022 Terryy Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <oleauto.h>
+#endif
+
+namespace tsmoreland::interop {
+
+    /// <summary>
+    /// how a <see cref="string_allocator"/> allocates and frees length prefixed strings such as BSTR
+    /// </summary>
+    template <typename Traits>
+    concept length_prefixed_string_traits = requires(typename Traits::char_type const* text, std::uint32_t length,
+        typename Traits::string_type string) {
+        // a new string of length code units copied from text, uninitialised if text is null; null on failure
+        { Traits::allocate(text, length) } noexcept -> std::same_as<typename Traits::string_type>;
+        { Traits::release(string) } noexcept;
+        { Traits::data(string) } noexcept -> std::same_as<typename Traits::char_type const*>;
+    };
+
+    /// <summary>
+    /// number of allocations and bytes allocated, including the length prefix and terminator
+    /// </summary>
+    struct string_allocation_statistics {
+        std::uint64_t allocations;
+        std::uint64_t bytes;
+    };
+
+    /// <summary>
+    /// allocates the strings a server hands out, counting allocations and bytes for each of its methods, and
+    /// interns strings it only lends, such as event arguments, so each is allocated once
+    /// </summary>
+    /// <remarks>
+    /// a string returned to a caller, a COM [out] BSTR, is owned and freed by the caller so must be a new
+    /// allocation each time; constant text should be passed as a view of known length so copying it never has to
+    /// search for its terminator
+    /// </remarks>
+    /// <typeparam name="Method">enum of the methods that allocate, with a final count enumerator</typeparam>
+    template <length_prefixed_string_traits Traits, typename Method>
+        requires std::is_enum_v<Method>
+    class string_allocator final {
+    public:
+        using char_type   = typename Traits::char_type;
+        using string_type = typename Traits::string_type;
+        using view_type   = std::basic_string_view<char_type>;
+
+        static constexpr std::size_t method_count = static_cast<std::size_t>(Method::count);
+
+        string_allocator() = default;
+
+        string_allocator(string_allocator const&)            = delete;
+        string_allocator& operator=(string_allocator const&) = delete;
+
+        ~string_allocator() {
+            for (auto const& [text, interned] : interned_) {
+                Traits::release(interned);
+            }
+        }
+
+        /// <returns>
+        /// a new string holding <paramref name="text"/>, owned by the caller, or null if it can't be allocated
+        /// </returns>
+        [[nodiscard]]
+        string_type allocate(Method const method, view_type const text) noexcept {
+            if (text.size() > std::numeric_limits<std::uint32_t>::max()) {
+                return string_type{};
+            }
+            return counted_allocate(method, text.data(), static_cast<std::uint32_t>(text.size()));
+        }
+
+        /// <returns>
+        /// a new string of <paramref name="length"/> uninitialised code units, owned by the caller, or null if it
+        /// can't be allocated
+        /// </returns>
+        [[nodiscard]]
+        string_type allocate(Method const method, std::uint32_t const length) noexcept {
+            return counted_allocate(method, nullptr, length);
+        }
+
+        /// <returns>
+        /// a string holding <paramref name="text"/>, allocated the first time it's interned and owned by this
+        /// allocator, or null if it can't be allocated; it must not be freed or modified
+        /// </returns>
+        [[nodiscard]]
+        string_type intern(Method const method, view_type const text) noexcept {
+            {
+                std::shared_lock const guard{lock_};
+                if (auto const existing = interned_.find(text); existing != interned_.end()) {
+                    return existing->second;
+                }
+            }
+
+            std::scoped_lock const guard{lock_};
+            if (auto const existing = interned_.find(text); existing != interned_.end()) {
+                return existing->second;
+            }
+            string_type const interned = allocate(method, text);
+            if (interned == string_type{}) {
+                return interned;
+            }
+            try {
+                // keyed by the interned copy, which lives as long as the entry
+                interned_.emplace(view_type{Traits::data(interned), text.size()}, interned);
+            } catch (std::bad_alloc const&) {
+                Traits::release(interned);
+                return string_type{};
+            }
+            return interned;
+        }
+
+        /// <returns>the allocations made for <paramref name="method"/> so far</returns>
+        [[nodiscard]]
+        string_allocation_statistics statistics(Method const method) const noexcept {
+            auto const& [allocations, bytes] = counters_[static_cast<std::size_t>(method)];
+            return {allocations.load(std::memory_order_relaxed), bytes.load(std::memory_order_relaxed)};
+        }
+
+        /// <returns>bytes allocated for a string of <paramref name="length"/> code units</returns>
+        [[nodiscard]]
+        static constexpr std::uint64_t allocation_size(std::uint32_t const length) noexcept {
+            return sizeof(std::uint32_t) + (static_cast<std::uint64_t>(length) + 1) * sizeof(char_type);
+        }
+
+    private:
+        struct counters {
+            std::atomic<std::uint64_t> allocations{0};
+            std::atomic<std::uint64_t> bytes{0};
+        };
+
+        string_type counted_allocate(Method const method, char_type const* const text, std::uint32_t const length)
+            noexcept {
+            string_type const string = Traits::allocate(text, length);
+            if (string != string_type{}) {
+                auto& [allocations, bytes] = counters_[static_cast<std::size_t>(method)];
+                allocations.fetch_add(1, std::memory_order_relaxed);
+                bytes.fetch_add(allocation_size(length), std::memory_order_relaxed);
+            }
+            return string;
+        }
+
+        std::array<counters, method_count> counters_{};
+        mutable std::shared_mutex lock_;
+        std::unordered_map<view_type, string_type> interned_;
+    };
+
+#ifdef _WIN32
+    /// <summary>
+    /// allocates BSTR with SysAllocStringLen, from the cache COM callers return them to with SysFreeString
+    /// </summary>
+    struct bstr_traits {
+        using char_type   = OLECHAR;
+        using string_type = BSTR;
+
+        static BSTR allocate(OLECHAR const* const text, std::uint32_t const length) noexcept {
+            return ::SysAllocStringLen(text, length);
+        }
+
+        static void release(BSTR const string) noexcept {
+            ::SysFreeString(string);
+        }
+
+        static OLECHAR const* data(BSTR const string) noexcept {
+            return string;
+        }
+    };
+#endif
+
+} // namespace tsmoreland::interop
@@ -0,0 +1,130 @@
+﻿//
+// Copyright © 2022 Terry Moreland
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, 
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace TSMoreland.Interop.SimpleObjectCOMProxy;
+
+/// <summary>
+/// vtable binding of ISimpleOOPObject3, declared up to GetImmutableProperties, for the members which take or return a
+/// GUID and so can't be called through <c>dynamic</c>
+/// </summary>
+/// <remarks>
+/// every member of ISimpleOOPObject, ISimpleOOPObject2 and ISimpleOOPObject3 is declared in IDL order as each fills a
+/// slot of the vtable, whether or not it's called from here
+/// </remarks>
+[Guid("6B72C858-4B94-42A5-BAEF-5A0DE2F7F78C")]
+[InterfaceType(ComInterfaceType.InterfaceIsDual)]
+[ComImport]
+internal interface ISimpleOOPObject3
+{
+    [DispId(1)]
+    string Name
+    {
+        [DispId(1)]
+        [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+        [return: MarshalAs(UnmanagedType.BStr)]
+        get;
+    }
+
+    [DispId(2)]
+    Guid Id
+    {
+        [DispId(2)]
+        [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+        get;
+    }
+
+    [DispId(3)]
+    int Numeric
+    {
+        [DispId(3)]
+        [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+        get;
+        [DispId(3)]
+        [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+        [param: In]
+        set;
+    }
+
+    [DispId(4)]
+    string Description
+    {
+        [DispId(4)]
+        [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+        [return: MarshalAs(UnmanagedType.BStr)]
+        get;
+    }
+
+    [DispId(5)]
+    [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+    [return: MarshalAs(UnmanagedType.BStr)]
+    string ToUpper([MarshalAs(UnmanagedType.BStr), In] string input);
+
+    [DispId(6)]
+    [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+    [return: MarshalAs(UnmanagedType.SafeArray, SafeArraySubType = VarEnum.VT_BSTR)]
+    string[] ToUpperMany([MarshalAs(UnmanagedType.SafeArray, SafeArraySubType = VarEnum.VT_BSTR), In] string[] inputs);
+
+    [DispId(7)]
+    bool AsyncEvents
+    {
+        [DispId(7)]
+        [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+        [return: MarshalAs(UnmanagedType.VariantBool)]
+        get;
+        [DispId(7)]
+        [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+        [param: MarshalAs(UnmanagedType.VariantBool), In]
+        set;
+    }
+
+    [DispId(8)]
+    [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+    void GetEventStatistics(out int queueDepth, out long coalesced, out long dropped);
+
+    [DispId(9)]
+    [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+    int AddNumeric([In] int delta);
+
+    [DispId(10)]
+    [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+    int CompareExchangeNumeric([In] int value, [In] int comparand);
+
+    [DispId(11)]
+    [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+    void GetStringStatistics(
+        [MarshalAs(UnmanagedType.SafeArray, SafeArraySubType = VarEnum.VT_BSTR)] out string[] methods,
+        [MarshalAs(UnmanagedType.SafeArray, SafeArraySubType = VarEnum.VT_I8)] out long[] allocations,
+        [MarshalAs(UnmanagedType.SafeArray, SafeArraySubType = VarEnum.VT_I8)] out long[] bytes);
+
+    [DispId(12)]
+    [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+    void GetActivationStatistics(out long activations, out long poolHits, out int idle,
+        out double meanMicroseconds, out double p99Microseconds, out double maxMicroseconds);
+
+    [DispId(13)]
+    [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+    [return: MarshalAs(UnmanagedType.BStr)]
+    string OpenChannel([In] int slotCount, [In] int slotSize);
+
+    [DispId(14)]
+    [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+    int ProcessChannel();
+
+    [DispId(15)]
+    [MethodImpl(MethodImplOptions.InternalCall, MethodCodeType = MethodCodeType.Runtime)]
+    void GetImmutableProperties([MarshalAs(UnmanagedType.BStr)] out string name, out Guid id,
+        [MarshalAs(UnmanagedType.BStr)] out string description);
+}
@@ -23,8 +23,20 @@ public sealed class SimpleOopObjectFacade : ISimpleOopObjectFacade
 {
     private readonly SimpleOOPObjectEventsProvider _provider;
     private readonly dynamic _object;
+    private readonly string? _name;
+    private readonly Guid? _id;
+    private readonly string? _description;
 
     public SimpleOopObjectFacade()
+        : this(false)
+    {
+    }
+
+    /// <param name="snapshotImmutableProperties">
+    /// if <c>true</c> <see cref="Name"/>, <see cref="Id"/> and <see cref="Description"/>, which never change, are
+    /// read here in a single call to the server and returned without a call to the server afterwards
+    /// </param>
+    public SimpleOopObjectFacade(bool snapshotImmutableProperties)
     {
         Guid classId = new("972b85e9-b7c9-467e-9c38-da5423ebcb1e");
         Type? classType = GetClassTypeFromId(classId);
@@ -36,7 +48,15 @@ public sealed class SimpleOopObjectFacade : ISimpleOopObjectFacade
 
         _object = Activator.CreateInstance(classType) ?? throw new COMException("Class not found");
         _provider = new SimpleOOPObjectEventsProvider(_object);
-        
+
+        if (snapshotImmutableProperties)
+        {
+            // through the vtable rather than dynamic, IDispatch can't return the GUID
+            ((ISimpleOOPObject3)_object).GetImmutableProperties(out string name, out Guid id, out string description);
+            _name = name;
+            _id = id;
+            _description = description;
+        }
     }
 
     public object Object => _object;
@@ -69,7 +89,7 @@ public sealed class SimpleOopObjectFacade : ISimpleOopObjectFacade
     }
 
 
-    public string Name => _object.Name;
+    public string Name => _name ?? _object.Name;
 
     public int Numeric
     {
@@ -81,6 +101,11 @@ public sealed class SimpleOopObjectFacade : ISimpleOopObjectFacade
     {
         get
         {
+            if (_id is { } id)
+            {
+                return id;
+            }
+
             try
             {
                 // this will throw an exception because dynamic seems to rely on IDispatch to call these properties/methods
@@ -113,7 +138,7 @@ public sealed class SimpleOopObjectFacade : ISimpleOopObjectFacade
     /// <summary>
     /// Description which comes from ISimpleObject2 
     /// </summary>
-    public string Description => _object.Description;
+    public string Description => _description ?? _object.Description;
 
 
     #region IDisposable